@@ -0,0 +1,387 @@
+#include "starlet-engine/engine.hpp"
+#include "starlet-engine/clock.hpp"
+
+#include "starlet-scene/component/grid.hpp"
+#include "starlet-scene/component/light.hpp"
+#include "starlet-scene/component/model.hpp"
+#include "starlet-scene/manager/scene_manager.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// starlet_engine_bench: generates synthetic scenes, loads and runs each one
+// for a fixed number of frames, and prints one JSON object per scene so runs
+// can be diffed between commits.
+//
+// Usage: starlet_engine_bench --assets <dir> [--backend offscreen|null|display]
+//                             [--frames N] [--case name] [--mesh file] [--out file]
+//                             [--entities N] [--replay log] [--timing csv]
+//
+// The "parallel_update" case runs a transform update over N synthetic
+// entities on JobSystems of 1..hardware threads to show update scaling.
+// "cubegrid_100x100x10_instanced" loads the same scene with grid instancing
+// on, so the grid's cubes and colour go through the engine's InstanceBatcher
+// and its draw_calls can be compared against the per-entity cubegrid case.
+// Draw calls are counted by wrapping the loaded GL draw entry points, so both
+// figures are measured.
+//
+// --replay drives the selected case from an input log recorded with
+// Engine::startInputRecording instead of running idle; --timing writes the
+// replay's per-frame timings as CSV for diffing between builds.
+
+namespace {
+  using Starlet::Engine::Engine;
+  using Starlet::Engine::FrameStats;
+  using Starlet::Engine::JobSystem;
+  using Starlet::Engine::WindowBackend;
+  namespace Clock = Starlet::Engine::Clock;
+
+  struct SceneSpec {
+    const char* name;
+    unsigned int models;
+    unsigned int lights;
+    unsigned int gridX, gridY, gridZ;
+    bool instanced;
+  };
+
+  constexpr SceneSpec SUITE[] = {
+    { "models_1k",                       1000,  1,   0,   0,  0, false },
+    { "models_10k",                     10000,  1,   0,   0,  0, false },
+    { "lights_64",                        100, 64,   0,   0,  0, false },
+    { "cubegrid_100x100x10",                0,  1, 100, 100, 10, false },
+    { "cubegrid_100x100x10_instanced",      0,  1, 100, 100, 10, true },
+  };
+
+  struct Options {
+    std::string assets;
+    std::string mesh{ "cube.ply" };
+    std::string only;
+    std::string out;
+    std::string replay;
+    std::string timing;
+    WindowBackend backend{ WindowBackend::Offscreen };
+    unsigned int frames{ 256 };
+    unsigned int entities{ 1000000 };
+  };
+
+  const char* backendName(const WindowBackend backend) {
+    switch (backend) {
+    case WindowBackend::Display:   return "display";
+    case WindowBackend::Offscreen: return "offscreen";
+    case WindowBackend::Null:      return "null";
+    }
+    return "unknown";
+  }
+
+  bool parseArgs(const int argc, char** argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+      const std::string flag = argv[i];
+      const std::string value = argv[i + 1];
+
+      if (flag == "--assets") options.assets = value;
+      else if (flag == "--mesh") options.mesh = value;
+      else if (flag == "--case") options.only = value;
+      else if (flag == "--out") options.out = value;
+      else if (flag == "--replay") options.replay = value;
+      else if (flag == "--timing") options.timing = value;
+      else if (flag == "--frames") options.frames = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+      else if (flag == "--entities") options.entities = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+      else if (flag == "--backend") {
+        if (value == "display") options.backend = WindowBackend::Display;
+        else if (value == "offscreen") options.backend = WindowBackend::Offscreen;
+        else if (value == "null") options.backend = WindowBackend::Null;
+        else return false;
+      }
+      else return false;
+    }
+    return !options.assets.empty() && options.frames > 0;
+  }
+
+  // Emits the synthetic scene in the starlet-scene text format: one
+  // whitespace-separated record per line, keyed by its leading type name.
+  bool writeSyntheticScene(const std::filesystem::path& path, const SceneSpec& spec, const std::string& mesh) {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "# Generated by starlet_engine_bench: " << spec.name << "\n";
+    file << "camera bench_camera 0 60 -220 0 0 1 60\n";
+
+    for (unsigned int i = 0; i < spec.lights; ++i) {
+      const float x = static_cast<float>(i % 8) * 40.0f - 140.0f;
+      const float z = static_cast<float>(i / 8) * 40.0f - 140.0f;
+      file << "light bench_light_" << i << " point " << x << " 30 " << z << " 1 1 1 1 0 0.01 0.001\n";
+    }
+
+    const unsigned int side = 100;
+    for (unsigned int i = 0; i < spec.models; ++i) {
+      const float x = static_cast<float>(i % side) * 2.5f - 125.0f;
+      const float z = static_cast<float>(i / side) * 2.5f - 125.0f;
+      file << "model bench_model_" << i << " " << mesh << " " << x << " 0 " << z << " 0 0 0 1 1 1 0.8 0.8 0.8 1\n";
+    }
+
+    if (spec.gridX > 0 && spec.gridY > 0 && spec.gridZ > 0)
+      file << "cubegrid bench_grid " << spec.gridX << " " << spec.gridY << " " << spec.gridZ << " 2 1 -100 0 -100 0.6 0.6 0.6 1\n";
+
+    return static_cast<bool>(file);
+  }
+
+  // Counts every draw the renderer and batcher issue by interposing on the
+  // glad function pointers. glad reloads them per context, so install() runs
+  // after each engine initializes.
+  namespace DrawCounter {
+    unsigned long long calls = 0;
+    PFNGLDRAWARRAYSPROC drawArrays = nullptr;
+    PFNGLDRAWELEMENTSPROC drawElements = nullptr;
+    PFNGLDRAWRANGEELEMENTSPROC drawRangeElements = nullptr;
+    PFNGLDRAWELEMENTSBASEVERTEXPROC drawElementsBaseVertex = nullptr;
+    PFNGLDRAWARRAYSINSTANCEDPROC drawArraysInstanced = nullptr;
+    PFNGLDRAWELEMENTSINSTANCEDPROC drawElementsInstanced = nullptr;
+
+    void APIENTRY countDrawArrays(GLenum mode, GLint first, GLsizei count) {
+      ++calls;
+      drawArrays(mode, first, count);
+    }
+    void APIENTRY countDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+      ++calls;
+      drawElements(mode, count, type, indices);
+    }
+    void APIENTRY countDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices) {
+      ++calls;
+      drawRangeElements(mode, start, end, count, type, indices);
+    }
+    void APIENTRY countDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex) {
+      ++calls;
+      drawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    }
+    void APIENTRY countDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+      ++calls;
+      drawArraysInstanced(mode, first, count, instances);
+    }
+    void APIENTRY countDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances) {
+      ++calls;
+      drawElementsInstanced(mode, count, type, indices, instances);
+    }
+
+    template<typename Proc>
+    void hook(Proc& entry, Proc& original, Proc counter) {
+      if (!entry || entry == counter) return;
+      original = entry;
+      entry = counter;
+    }
+
+    void install() {
+      hook(glad_glDrawArrays, drawArrays, &countDrawArrays);
+      hook(glad_glDrawElements, drawElements, &countDrawElements);
+      hook(glad_glDrawRangeElements, drawRangeElements, &countDrawRangeElements);
+      hook(glad_glDrawElementsBaseVertex, drawElementsBaseVertex, &countDrawElementsBaseVertex);
+      hook(glad_glDrawArraysInstanced, drawArraysInstanced, &countDrawArraysInstanced);
+      hook(glad_glDrawElementsInstanced, drawElementsInstanced, &countDrawElementsInstanced);
+      calls = 0;
+    }
+  }
+
+  struct ParsedCounts {
+    size_t models{ 0 };
+    size_t lights{ 0 };
+    size_t grids{ 0 };
+    unsigned long long gridCells{ 0 };
+  };
+
+  // The generated text must round-trip through the real starlet-scene
+  // parser; a record it silently skips would make every figure meaningless.
+  // It is parsed into a scene of its own, before resources load, so grids
+  // are still grids whether or not the engine later expands them.
+  bool checkParsedScene(const std::filesystem::path& sceneDir, const SceneSpec& spec, ParsedCounts& counts) {
+    Starlet::Scene::SceneManager parsed;
+    const std::string basePath = sceneDir.string();
+    parsed.setBasePath(basePath.c_str());
+    if (!parsed.loadTxtScene(std::string(spec.name) + ".txt")) {
+      std::fprintf(stderr, "Scene %s failed to parse\n", spec.name);
+      return false;
+    }
+
+    auto& scene = parsed.getScene();
+    counts.models = scene.getComponentsOfType<Starlet::Scene::Model>().size();
+    counts.lights = scene.getComponentsOfType<Starlet::Scene::Light>().size();
+    bool gridsMatch = true;
+    for (const Starlet::Scene::Grid* grid : scene.getComponentsOfType<Starlet::Scene::Grid>()) {
+      ++counts.grids;
+      counts.gridCells += static_cast<unsigned long long>(grid->countX) * grid->countY * grid->countZ;
+      gridsMatch = gridsMatch && grid->countX == spec.gridX && grid->countY == spec.gridY && grid->countZ == spec.gridZ;
+    }
+
+    const size_t expectedGrids = spec.gridX > 0 && spec.gridY > 0 && spec.gridZ > 0 ? 1 : 0;
+    if (counts.models == spec.models && counts.lights == spec.lights && counts.grids == expectedGrids && gridsMatch) return true;
+
+    std::fprintf(stderr, "Scene %s parsed %zu model(s), %zu light(s) and %zu grid(s) of %llu cell(s), expected %u, %u and %zu of %ux%ux%u;"
+      " the bench scene format no longer matches starlet-scene\n",
+      spec.name, counts.models, counts.lights, counts.grids, counts.gridCells, spec.models, spec.lights, expectedGrids, spec.gridX, spec.gridY, spec.gridZ);
+    return false;
+  }
+
+  void writeResult(FILE* out, const SceneSpec& spec, const ParsedCounts& counts, Engine& engine, const unsigned long long framesRun) {
+    const FrameStats& update = engine.getUpdateTimes();
+    const FrameStats& frame = engine.getFrameTimes();
+
+    std::fprintf(out, "{\"scene\":\"%s\",\"backend\":\"%s\",\"graphics\":%s,\"models\":%u,\"lights\":%u,\"grid\":[%u,%u,%u],\"frames\":%llu",
+      spec.name, backendName(engine.getWindowBackend()), engine.hasGraphics() ? "true" : "false",
+      spec.models, spec.lights, spec.gridX, spec.gridY, spec.gridZ, framesRun);
+
+    std::fprintf(out, ",\"load_ms\":%.3f,\"load_stages_ms\":{", engine.getLoadStats().getTotalSeconds() * 1000.0);
+    const auto& stages = engine.getLoadStats().getStages();
+    for (size_t i = 0; i < stages.size(); ++i)
+      std::fprintf(out, "%s\"%s\":%.3f", i == 0 ? "" : ",", stages[i].name.c_str(), stages[i].seconds * 1000.0);
+
+    // entities is one draw per parsed model or grid cell if nothing were
+    // batched; per_frame is what the GL draw entry points actually saw.
+    const unsigned long long entities = counts.models + counts.gridCells;
+    std::fprintf(out, "},\"entities\":%llu", entities);
+    if (engine.hasGraphics() && framesRun > 0)
+      std::fprintf(out, ",\"draw_calls\":{\"per_frame\":%.1f,\"total\":%llu}", static_cast<double>(DrawCounter::calls) / framesRun, DrawCounter::calls);
+    else std::fputs(",\"draw_calls\":null", out);
+
+    std::fprintf(out, ",\"update_ms\":{\"avg\":%.4f,\"p50\":%.4f,\"p99\":%.4f}", update.getAverage(), update.getP50(), update.getP99());
+    std::fprintf(out, ",\"frame_ms\":{\"avg\":%.4f,\"p50\":%.4f,\"p99\":%.4f}}\n", frame.getAverage(), frame.getP50(), frame.getP99());
+    std::fflush(out);
+  }
+
+  struct BenchTransform {
+    float position[3];
+    float velocity[3];
+    float rotation[3];
+    float scale[3];
+    float model[16];
+  };
+
+  void updateTransforms(BenchTransform* transforms, const size_t begin, const size_t end, const float deltaTime) {
+    for (size_t i = begin; i < end; ++i) {
+      BenchTransform& t = transforms[i];
+      for (int axis = 0; axis < 3; ++axis) {
+        t.position[axis] += t.velocity[axis] * deltaTime;
+        t.rotation[axis] += deltaTime;
+      }
+
+      // Y-then-X rotation, scale and translation, matching a typical model matrix build.
+      const float cy = std::cos(t.rotation[1]), sy = std::sin(t.rotation[1]);
+      const float cx = std::cos(t.rotation[0]), sx = std::sin(t.rotation[0]);
+      const float m[16] = {
+        cy * t.scale[0],           0.0f,           -sy * t.scale[0],           0.0f,
+        sy * sx * t.scale[1],      cx * t.scale[1], cy * sx * t.scale[1],      0.0f,
+        sy * cx * t.scale[2],     -sx * t.scale[2], cy * cx * t.scale[2],      0.0f,
+        t.position[0],             t.position[1],   t.position[2],             1.0f
+      };
+      std::copy(m, m + 16, t.model);
+    }
+  }
+
+  void runParallelUpdate(FILE* out, const Options& options) {
+    std::vector<BenchTransform> transforms(options.entities);
+    for (size_t i = 0; i < transforms.size(); ++i) {
+      const float f = static_cast<float>(i);
+      transforms[i] = { { f, 0.0f, -f }, { 1.0f, 0.5f, -1.0f }, { 0.0f, f * 0.01f, 0.0f }, { 1.0f, 1.0f, 1.0f }, {} };
+    }
+
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < hardware; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(hardware);
+
+    constexpr int ITERATIONS = 32;
+    double baselineMs = 0.0;
+    for (const unsigned int threads : threadCounts) {
+      JobSystem jobs(threads - 1);
+      FrameStats times;
+
+      for (int i = 0; i < ITERATIONS; ++i) {
+        const Clock::Ticks start = Clock::now();
+        jobs.parallelFor(transforms.size(), 4096, [&transforms](const size_t begin, const size_t end) {
+          updateTransforms(transforms.data(), begin, end, 1.0f / 60.0f);
+        });
+        times.record(Clock::toMilliseconds(Clock::now() - start));
+      }
+
+      const double p50 = times.getP50();
+      if (threads == 1) baselineMs = p50;
+      std::fprintf(out, "{\"scene\":\"parallel_update\",\"threads\":%u,\"entities\":%u,\"update_ms\":{\"avg\":%.4f,\"p50\":%.4f,\"p99\":%.4f},\"entities_per_sec\":%.0f,\"speedup\":%.3f}\n",
+        threads, options.entities, times.getAverage(), p50, times.getP99(),
+        p50 > 0.0 ? options.entities / (p50 / 1000.0) : 0.0, p50 > 0.0 ? baselineMs / p50 : 0.0);
+      std::fflush(out);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    std::fprintf(stderr, "Usage: %s --assets <dir> [--backend offscreen|null|display] [--frames N] [--case name] [--mesh file] [--out file] [--entities N] [--replay log] [--timing csv]\n", argv[0]);
+    return 1;
+  }
+
+  FILE* out = options.out.empty() ? stdout : std::fopen(options.out.c_str(), "w");
+  if (!out) {
+    std::fprintf(stderr, "Failed to open output file: %s\n", options.out.c_str());
+    return 1;
+  }
+
+  const std::filesystem::path sceneDir = std::filesystem::temp_directory_path() / "starlet_engine_bench";
+  std::error_code ec;
+  std::filesystem::create_directories(sceneDir, ec);
+
+  int failures = 0;
+  for (const SceneSpec& spec : SUITE) {
+    if (!options.only.empty() && options.only != spec.name) continue;
+
+    if (!writeSyntheticScene(sceneDir / (std::string(spec.name) + ".txt"), spec, options.mesh)) {
+      std::fprintf(stderr, "Failed to write synthetic scene: %s\n", spec.name);
+      ++failures;
+      continue;
+    }
+
+    ParsedCounts counts;
+    if (!checkParsedScene(sceneDir, spec, counts)) {
+      ++failures;
+      continue;
+    }
+
+    // A fresh engine per scene keeps GL and scene state from leaking between cases.
+    std::unique_ptr<Engine> engine = std::make_unique<Engine>();
+    engine->setWindowBackend(options.backend);
+    engine->setPresentMode(Starlet::Engine::PresentMode::Uncapped);
+    engine->setAssetPaths(options.assets);
+    engine->setScenePath(sceneDir.string());
+    engine->setGridInstancing(spec.instanced);
+
+    if (!engine->initialize(1280, 720, "starlet_engine_bench") || !engine->loadScene(spec.name)) {
+      std::fprintf(stderr, "Failed to set up scene: %s\n", spec.name);
+      ++failures;
+      continue;
+    }
+
+    if (!options.replay.empty() && !engine->startInputReplay(options.replay, options.timing)) {
+      ++failures;
+      continue;
+    }
+
+    // Counting starts after setup so only per-frame draws are measured.
+    if (engine->hasGraphics()) DrawCounter::install();
+    engine->run(options.frames);
+    writeResult(out, spec, counts, *engine, engine->getFrameIndex());
+  }
+
+  if (options.only.empty() || options.only == "parallel_update")
+    runParallelUpdate(out, options);
+
+  std::filesystem::remove_all(sceneDir, ec);
+  if (out != stdout) std::fclose(out);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "starlet-engine/thread_pool.hpp"
+#include "starlet-engine/upload_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Starlet::Engine {
+  // Runs decode work (disk reads, parsing, image decoding) on a worker pool
+  // and funnels the resulting GL uploads through a bounded queue that the
+  // context thread drains in finish(), or without blocking in pump(). A
+  // decode returning an empty Upload is treated as a failed asset.
+  //
+  // Work can be grouped into a batch so a caller waits only for its own
+  // assets; finish(batch) still applies unrelated uploads that arrive while
+  // it waits, since they share the queue.
+  class AssetLoader {
+  public:
+    using Upload = UploadQueue::Upload;
+    using Decode = std::function<Upload()>;
+    // Uploads applied in order, each on its own, so one asset's GL work can be spread across frames.
+    using StepDecode = std::function<std::vector<Upload>()>;
+    using Batch = unsigned int;
+    static constexpr Batch NO_BATCH{ 0 };
+
+    explicit AssetLoader(const unsigned int threadCount = 0, const size_t queueCapacity = 64);
+    ~AssetLoader();
+
+    Batch createBatch();
+    void enqueue(Decode decode, const Batch batch = NO_BATCH);
+    // An empty step list is treated as a failed asset.
+    void enqueueSteps(StepDecode decode);
+    // Runs work with no GL side, such as warming the page cache, on the pool.
+    // It never touches the upload queue, so it cannot block on a full one.
+    void run(std::function<bool()> task, const Batch batch);
+    // Waits for and applies everything submitted so far.
+    bool finish();
+    // Waits until every asset in batch is applied; false if any failed.
+    bool finish(const Batch batch);
+    // Waits until every task run() in batch has returned, without applying
+    // uploads, so only use it for batches that have no enqueue()d assets.
+    bool wait(const Batch batch);
+    // Applies only the uploads that are already decoded; returns how many ran.
+    // With a budget, stops once that many milliseconds have been spent (after at least one).
+    size_t pump(const double budgetMs = 0.0);
+
+    size_t getPending() const { return submitted; }
+    size_t getPending(const Batch batch) const;
+    unsigned int getThreadCount() const { return pool.getThreadCount(); }
+
+  private:
+    struct BatchState {
+      size_t pending{ 0 };
+      size_t failed{ 0 };
+    };
+
+    UploadQueue uploads;
+    ThreadPool pool;
+    std::atomic<size_t> submitted{ 0 };
+
+    mutable std::mutex batchMutex;
+    std::condition_variable batchSettled;
+    std::unordered_map<Batch, BatchState> batches;
+    Batch nextBatch{ NO_BATCH + 1 };
+
+    bool apply(Upload& upload);
+  };
+}
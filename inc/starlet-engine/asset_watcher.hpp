@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Starlet::Engine {
+  // Watches an asset tree on a background thread (inotify on Linux, mtime
+  // polling elsewhere) and reports files once they have stopped changing for
+  // the debounce interval. That way an editor's write-rename-touch sequence
+  // shows up as a single change.
+  class AssetWatcher {
+  public:
+    AssetWatcher() = default;
+    ~AssetWatcher() { stop(); }
+
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    // Directories (relative to the root) whose changes are never reported,
+    // e.g. caches the engine itself writes. Takes effect on the next start().
+    void setExcluded(std::vector<std::string> directories) { excluded = std::move(directories); }
+
+    // Fails without starting a thread if the root is not a directory or the
+    // platform watch cannot be created.
+    bool start(const std::string& rootIn, const std::chrono::milliseconds debounceIn = std::chrono::milliseconds(150));
+    void stop();
+    // False once the watch thread has exited, whether stopped or failed.
+    bool isRunning() const { return running; }
+
+    // Appends settled changes since the last call, as '/'-separated paths relative to the root.
+    void takeChanges(std::vector<std::string>& out);
+
+  private:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    std::string root;
+    std::vector<std::string> excluded;
+    std::chrono::milliseconds debounce{ 150 };
+    std::thread thread;
+    std::atomic<bool> stopping{ false };
+    std::atomic<bool> running{ false };
+    int descriptor{ -1 };
+
+    std::unordered_map<std::string, TimePoint> pending;
+    std::mutex readyMutex;
+    std::vector<std::string> ready;
+
+    bool isExcluded(const std::string& relativePath) const;
+    void markChanged(const std::string& relativePath);
+    void flushSettled();
+
+    void watchLoop();
+  };
+}
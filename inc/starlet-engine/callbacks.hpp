@@ -9,4 +9,9 @@ void framebuffer_size_callback(GLFWwindow* window, const int width, const int he
 void key_callback(GLFWwindow* window, const int key, const int scancode, const int action, const int mods);
 
 void scroll_callback(GLFWwindow* window, const double xoffset, const double yoffset);
-void mouse_button_callback(GLFWwindow* window, const int button, const int action, const int mods);
\ No newline at end of file
+void mouse_button_callback(GLFWwindow* window, const int button, const int action, const int mods);
+void cursor_position_callback(GLFWwindow* window, const double xpos, const double ypos);
+
+void window_focus_callback(GLFWwindow* window, const int focused);
+void window_iconify_callback(GLFWwindow* window, const int iconified);
+void window_refresh_callback(GLFWwindow* window);
\ No newline at end of file
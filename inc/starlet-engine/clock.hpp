@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Starlet::Engine::Clock {
+  // Monotonic nanosecond ticks. Integer ticks keep full precision regardless
+  // of uptime, unlike float seconds from glfwGetTime().
+  using Ticks = std::int64_t;
+
+  inline Ticks now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  inline double toSeconds(const Ticks ticks)      { return static_cast<double>(ticks) * 1e-9; }
+  inline double toMilliseconds(const Ticks ticks) { return static_cast<double>(ticks) * 1e-6; }
+  inline double toMicroseconds(const Ticks ticks) { return static_cast<double>(ticks) * 1e-3; }
+  inline Ticks  fromSeconds(const double seconds) { return static_cast<Ticks>(seconds * 1e9); }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Starlet::Engine {
+  // 64-bit FNV-1a. Used to key on-disk caches by the content of their source.
+  constexpr std::uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+  inline std::uint64_t hashBytes(const void* data, const size_t size, std::uint64_t hash = HASH_SEED) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  inline std::uint64_t hashString(const std::string& text, const std::uint64_t hash = HASH_SEED) {
+    return hashBytes(text.data(), text.size(), hash);
+  }
+
+  bool hashFile(const std::string& path, std::uint64_t& hash);
+}
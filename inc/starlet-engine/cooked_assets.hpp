@@ -0,0 +1,155 @@
+#pragma once
+
+#include "starlet-engine/asset_loader.hpp"
+#include "starlet-engine/instance_batcher.hpp"
+#include "starlet-engine/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Starlet::Engine {
+  // GPU-ready forms of source meshes and textures, written by
+  // starlet_asset_cook beside their source (model.ply -> model.smesh,
+  // brick.bmp -> brick.stex). Both record the size, modification time and
+  // content hash of the source they were cooked from. A matching size and
+  // time accept the file without reading the source; otherwise the hash
+  // decides, so a stale file is never mistaken for current.
+  enum class CookStatus {
+    Valid,
+    Missing,
+    Stale,
+    NoSource
+  };
+
+  enum CookedVertexAttribute : std::uint32_t {
+    VERTEX_POSITION = 1 << 0, // 3 floats
+    VERTEX_NORMAL   = 1 << 1, // 3 floats
+    VERTEX_TEXCOORD = 1 << 2, // 2 floats
+    VERTEX_COLOR    = 1 << 3  // 4 unsigned bytes, normalized
+  };
+
+  enum class CookedTextureFormat : std::uint32_t {
+    RGBA8 = 0,
+    BC1 = 1
+  };
+
+  struct CookedMeshHeader {
+    std::uint32_t magic;
+    std::uint32_t formatVersion;
+    std::uint64_t sourceHash;
+    std::uint64_t sourceSize;
+    std::int64_t sourceModified;
+    std::uint32_t attributes;
+    std::uint32_t vertexStride;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t indexSize; // 2 or 4 bytes
+    std::uint32_t reserved;
+  };
+
+  struct CookedMipLevel {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t offset; // from the start of the pixel data
+    std::uint64_t size;
+  };
+
+  struct CookedTextureHeader {
+    std::uint32_t magic;
+    std::uint32_t formatVersion;
+    std::uint64_t sourceHash;
+    std::uint64_t sourceSize;
+    std::int64_t sourceModified;
+    std::uint32_t format;
+    std::uint32_t mipCount;
+    std::uint32_t width;
+    std::uint32_t height;
+  };
+
+  // GL objects created from a cooked mesh; the caller owns and deletes them.
+  struct CookedMeshBuffers {
+    unsigned int vertexArray{ 0 };
+    unsigned int vertexBuffer{ 0 };
+    unsigned int indexBuffer{ 0 };
+    unsigned int indexCount{ 0 };
+    unsigned int indexType{ 0 };
+
+    // Cooked meshes bypass the scene's ResourceManager and are drawn through the InstanceBatcher.
+    InstanceBatchKey batchKey(const unsigned int texture = 0) const { return { vertexArray, indexCount, texture, indexType }; }
+  };
+
+  // Memory-mapped cooked mesh. The vertex and index views point straight
+  // into the mapping and are handed to glBufferData without a copy.
+  class CookedMesh {
+  public:
+    static constexpr std::uint32_t MAGIC = 0x48534D53; // "SMSH"
+    static constexpr std::uint32_t FORMAT_VERSION = 2;
+
+    static std::string cookedPathFor(const std::string& sourcePath);
+    static std::uint32_t strideFor(const std::uint32_t attributes);
+    static CookStatus check(const std::string& sourcePath);
+
+    // False if the cooked file is missing, stale or malformed; load the source instead.
+    bool open(const std::string& sourcePath);
+    void close() { file.close(); }
+
+    const CookedMeshHeader& getHeader() const { return header; }
+    const unsigned char* getVertices() const { return file.data() + sizeof(CookedMeshHeader); }
+    const unsigned char* getIndices() const { return getVertices() + size_t{ header.vertexCount } * header.vertexStride; }
+
+    // Context thread. Attributes are bound at the shared VertexLocation slots.
+    bool upload(CookedMeshBuffers& out) const;
+
+    static bool write(const std::string& path, const CookedMeshHeader& header, const std::vector<unsigned char>& vertices, const std::vector<unsigned char>& indices);
+
+  private:
+    MappedFile file;
+    CookedMeshHeader header{};
+  };
+
+  class CookedTexture {
+  public:
+    static constexpr std::uint32_t MAGIC = 0x58545353; // "SSTX"
+    static constexpr std::uint32_t FORMAT_VERSION = 2;
+    static constexpr std::uint32_t MAX_MIP_COUNT = 32;
+
+    // Bytes a mip of this size takes in format.
+    static std::uint64_t mipSizeFor(const CookedTextureFormat format, const std::uint32_t width, const std::uint32_t height);
+
+    static std::string cookedPathFor(const std::string& sourcePath);
+    static CookStatus check(const std::string& sourcePath);
+
+    bool open(const std::string& sourcePath);
+    void close() { file.close(); }
+
+    const CookedTextureHeader& getHeader() const { return header; }
+    const CookedMipLevel& getMip(const std::uint32_t level) const { return mips()[level]; }
+    const unsigned char* getMipData(const std::uint32_t level) const { return pixels() + getMip(level).offset; }
+
+    // Context thread. Returns false (and creates nothing) if the driver lacks
+    // the stored compression format, so the caller can fall back to the source.
+    bool upload(unsigned int& texture) const;
+
+    static bool write(const std::string& path, const CookedTextureHeader& header, const std::vector<CookedMipLevel>& mips, const std::vector<unsigned char>& pixels);
+
+  private:
+    MappedFile file;
+    CookedTextureHeader header{};
+
+    const CookedMipLevel* mips() const { return reinterpret_cast<const CookedMipLevel*>(file.data() + sizeof(CookedTextureHeader)); }
+    const unsigned char* pixels() const { return file.data() + sizeof(CookedTextureHeader) + size_t{ header.mipCount } * sizeof(CookedMipLevel); }
+  };
+
+  // The size and modification time recorded in cooked headers. False if the source is unreadable.
+  bool readSourceStamp(const std::string& sourcePath, std::uint64_t& size, std::int64_t& modified);
+
+  // AssetLoader decode steps: the cooked file is mapped and validated on the
+  // loader thread and uploaded on the context thread straight from the
+  // mapping. When it is missing, stale or unsupported, fallback (the source
+  // loader) runs instead.
+  AssetLoader::Decode decodeCookedMesh(const std::string& sourcePath, std::function<bool(const CookedMeshBuffers&)> onLoaded, AssetLoader::Decode fallback);
+  AssetLoader::Decode decodeCookedTexture(const std::string& sourcePath, std::function<bool(unsigned int)> onLoaded, AssetLoader::Decode fallback);
+}
@@ -2,6 +2,26 @@
 
 #include "starlet-engine/window_manager.hpp"
 #include "starlet-engine/timer.hpp"
+#include "starlet-engine/frame_pacer.hpp"
+#include "starlet-engine/frame_demand.hpp"
+#include "starlet-engine/fixed_timestep.hpp"
+#include "starlet-engine/asset_loader.hpp"
+#include "starlet-engine/asset_watcher.hpp"
+#include "starlet-engine/resource_registry.hpp"
+#include "starlet-engine/job_system.hpp"
+#include "starlet-engine/frame_arena.hpp"
+#include "starlet-engine/frame_context.hpp"
+#include "starlet-engine/system_scheduler.hpp"
+#include "starlet-engine/load_stats.hpp"
+#include "starlet-engine/frame_stats.hpp"
+#include "starlet-engine/program_cache.hpp"
+#include "starlet-engine/render_thread.hpp"
+#include "starlet-engine/instance_batcher.hpp"
+#include "starlet-engine/frame_capture.hpp"
+#include "starlet-engine/input_event_queue.hpp"
+#include "starlet-engine/input_log.hpp"
+#include "starlet-engine/latency_histogram.hpp"
+#include "starlet-engine/scene_assets.hpp"
 #include "starlet-controls/input_manager.hpp"
 
 #include "starlet-scene/manager/scene_manager.hpp"
@@ -14,37 +34,255 @@
 namespace Starlet::Engine {
 	class Engine {
 	public:
+		// Returns a decode job for a changed asset (path relative to the asset
+		// root), or an empty Decode if the handler does not own that file.
+		using AssetReloadHandler = std::function<AssetLoader::Decode(const std::string& relativePath)>;
+		// Runs on a loader thread with a freshly parsed scene. Acquires handles
+		// for what is already resident into keep, decodes the rest, and returns
+		// the upload (or nothing) that inserts the new resources on the context thread.
+		using ScenePreloader = std::function<AssetLoader::Upload(Scene::SceneManager& staged, ResourceRegistry& registry, ResourceList& keep)>;
+		// Called with the interpolation alpha before the renderer draws the
+		// scene, then with 1 once it has, so transforms can be blended between
+		// the last two fixed steps for the draw and restored afterwards.
+		using RenderInterpolator = std::function<void(Scene::Scene& scene, const float alpha)>;
+
 		Engine();
 		~Engine() = default;
 
 		void setAssetPaths(const std::string& path);
+		void setScenePath(const std::string& path);
+		// Where the engine writes its caches (shader binaries). Defaults to
+		// <assets>.cache beside the asset directory so hot reload never sees
+		// the engine's own writes; call after setAssetPaths to override.
+		void setCachePath(const std::string& path);
+		void setWindowBackend(const WindowBackend backend) { windowManager.setBackend(backend); }
+		WindowBackend getWindowBackend() const { return windowManager.getBackend(); }
+		bool hasGraphics() const { return windowManager.hasContext(); }
+
 		bool initialize(const unsigned int width, const unsigned int height, const char* title);
 
 		bool loadScene(const std::string& sceneIn = "Default");
-		void run();
 
-		void updateViewport(const int width, const int height) { windowManager.updateViewport(width, height); }
+		// Parses the next scene and loads its resources in the background while
+		// the current one keeps running; activatePreloadedScene() swaps it in
+		// between frames and evicts resources no longer referenced.
+		bool preloadScene(const std::string& sceneIn);
+		bool isScenePreloaded() const { return stagedReady; }
+		bool activatePreloadedScene();
+		void setScenePreloader(ScenePreloader preloader) { scenePreloader = std::move(preloader); }
+		ResourceRegistry& getResourceRegistry() { return resourceRegistry; }
+		// Engine-built programs by name ("shader1"), whether linked from source or the binary cache; 0 if unknown.
+		unsigned int getShaderProgram(const std::string& name) const { return programCache.getProgram(name); }
+		void run(const unsigned int frameCount = 0);
+
+		JobSystem& getJobSystem() { return jobSystem; }
+		const FrameContext& getFrameContext() const { return frameContext; }
+		FrameArenas& getFrameArenas() { return frameArenas; }
+		Scene::SceneManager& getSceneManager() { return *sceneManager; }
+		void registerSystem(const std::string& name, SystemAccess access, SystemScheduler::Update update) { systemScheduler.add(name, std::move(access), std::move(update)); }
+
+		AssetLoader& getAssetLoader() { return assetLoader; }
+
+		bool setHotReload(const bool enabled);
+		bool isHotReloadEnabled() const { return assetWatcher.isRunning(); }
+		void addAssetReloadHandler(AssetReloadHandler handler) { reloadHandlers.push_back(std::move(handler)); }
+		const LoadStats& getLoadStats() const { return loadStats; }
+		const FrameStats& getUpdateTimes() const { return updateTimes; }
+		const FrameStats& getFrameTimes() const { return frameTimes; }
+		unsigned long long getFrameIndex() const { return frameIndex; }
+
+		void setFixedTimestep(const double tickRate, const unsigned int maxStepsPerFrame = 5);
+		void setVariableTimestep() { fixedStepEnabled = false; }
+		bool isFixedTimestep() const { return fixedStepEnabled; }
+		float getInterpolationAlpha() const { return fixedStepEnabled ? fixedTimestep.getAlpha() : 1.0f; }
+		void setRenderInterpolator(RenderInterpolator interpolator) { renderInterpolator = std::move(interpolator); }
+
+		void setPresentMode(const PresentMode mode, const double targetFps = 0.0);
+		const FramePacer& getFramePacer() const { return framePacer; }
+
+		// On demand, run() sleeps in glfwWaitEventsTimeout and only updates and
+		// renders when input arrives, a redraw is requested, a timer fires or an
+		// animation is running. Minimised windows stop rendering and unfocused
+		// ones drop to the background frame rate (10 fps by default).
+		void setOnDemandRendering(const bool enabled);
+		bool isOnDemandRendering() const { return onDemandRendering; }
+		// Safe from any thread; wakes an idle loop.
+		void requestRedraw(const unsigned int frames = 1);
+		void requestRedrawAfter(const double seconds);
+		// Frames render continuously between begin and end, e.g. while a tween runs.
+		void beginAnimation() { frameDemand.beginAnimation(); postEmptyEvent(); }
+		void endAnimation() { frameDemand.endAnimation(); }
+		void setBackgroundFrameRate(const double fps) { frameDemand.setBackgroundFrameRate(fps); }
+		double getIdleSeconds() const { return Clock::toSeconds(idleTicks); }
 
-		void onKey(const KeyEvent& event) { inputManager.onKey(event); }
-		void onScroll(const Input::ScrollEvent& event) { inputManager.onScroll(event); }
-		void onButton(const Input::MouseButtonEvent& event) { inputManager.onButton(event); }
+		void setPipelinedRendering(const bool enabled) { pipelinedRendering = enabled; }
+		bool isPipelinedRendering() const { return pipelinedRendering; }
+		FrameStats getPresentLatency() const { return renderThread.getLatency(); }
+
+		// Drawn after the scene each frame, under the scene program's uniforms.
+		// Its instances belong to the active scene and are dropped when another loads.
+		InstanceBatcher& getInstanceBatcher() { return instanceBatcher; }
+		// On by default: each Grid's cells become instances of one shared
+		// primitive mesh, one draw per grid, instead of one entity per cell.
+		void setGridInstancing(const bool enabled) { gridInstancing = enabled; }
+		bool isGridInstancing() const { return gridInstancing; }
+
+		// Records every presented frame through an asynchronous PBO readback;
+		// PNG encoding and file writes stay off the render thread.
+		bool startCapture(const CaptureSettings& settings);
+		void stopCapture();
+		const FrameCapture& getFrameCapture() const { return frameCapture; }
+
+		void updateViewport(const int width, const int height);
+
+		void onKey(const KeyEvent& event);
+		void onScroll(const Input::ScrollEvent& event);
+		void onButton(const Input::MouseButtonEvent& event);
+		void onCursorMove() { frameDemand.markDirty(); }
+		void onWindowFocus(const bool focused);
+		void onWindowIconify(const bool iconified);
+
+		// Recording captures each frame's input, cursor position and delta. A
+		// replay feeds them back instead of live input and the wall clock, then
+		// ends run() when the log runs out; timingPath gets per-frame CSV timings.
+		// Closing the window or ESC still ends a replay early.
+		bool startInputRecording(const std::string& path);
+		void stopInputRecording() { inputRecorder.close(); }
+		bool startInputReplay(const std::string& path, const std::string& timingPath = "");
+		bool isReplayingInput() const { return inputReplay.isOpen(); }
+
+		const LatencyHistogram& getInputLatency() const { return inputLatency; }
+		std::uint64_t getDroppedInputEvents() const { return inputEvents.getDropped(); }
 
 		void toggleCursorLock() { inputManager.setCursorLocked(windowManager.switchCursorLock()); }
-		void toggleWireframe() { glState.toggleWireframe(); };
+		void toggleWireframe();
+		void toggleTraceCapture();
+		void toggleFrameCapture();
 
 	private:
 		WindowManager windowManager;
 		Timer timer;
+		FramePacer framePacer;
+		FrameDemand frameDemand;
+		bool onDemandRendering{ false };
+		Clock::Ticks idleTicks{ 0 };
+		FixedTimestep fixedTimestep;
+		bool fixedStepEnabled{ false };
+		bool inputConsumed{ true };
 		Input::InputManager inputManager;
+		InputEventQueue<256> inputEvents;
+		LatencyHistogram inputLatency;
+		Clock::Ticks pendingInputTimestamp{ 0 };
+		// Set when key or button events went to the InputManager's own queues.
+		bool managerEventsQueued{ false };
+		InputRecorder inputRecorder;
+		InputReplay inputReplay;
+		InputLogFrame replayFrame;
 		Graphics::GLStateManager glState;
 
+		ProgramCache programCache;
 		Graphics::ShaderManager shaderManager;
-		Graphics::ResourceManager resourceManager;
-		Scene::SceneManager sceneManager;
+		unsigned int programBuilds{ 0 };
+		// The active scene and the one being preloaded; activation swaps the pointer.
+		Scene::SceneManager sceneSlots[2];
+		Scene::SceneManager* sceneManager{ &sceneSlots[0] };
+		Scene::SceneManager* stagedSceneManager{ &sceneSlots[1] };
+		std::string stagedSceneName;
+		LoadStats stagedLoadStats;
+		std::atomic<bool> stagedReady{ false };
+		std::atomic<bool> preloading{ false };
+		// Context thread; set by the first preload step that fails, so the rest are skipped.
+		bool stagedFailed{ false };
+		ScenePreloader scenePreloader;
+		ResourceRegistry resourceRegistry;
+		ResourceList sceneResources;
+		ResourceList stagedResources;
+		// What a scene's meshes and textures are loaded into, and the renderer
+		// drawing from them. Each load creates one, owned by a registry entry in
+		// that scene's resource list, so collect() frees the outgoing scene's.
+		struct SceneGraphics {
+			Graphics::ResourceManager resources;
+			Graphics::Renderer renderer{ resources };
+		};
+		// By scene slot; cleared when the entry is released.
+		SceneGraphics* sceneGraphics[2]{ nullptr, nullptr };
+		std::uint64_t sceneGraphicsLoads{ 0 };
+		std::vector<std::string> stagedSceneAssets;
+		std::string assetPath;
+		std::string scenePath;
+		std::string cachePath;
+		std::string activeSceneName;
+		// Files under the asset root the active scene references, relative to it.
+		std::vector<std::string> sceneAssets;
+		// Built on the first scene load and shared with the preload worker.
+		std::mutex assetIndexMutex;
+		AssetIndex assetIndex;
+
+		RenderThread renderThread;
+		InstanceBatcher instanceBatcher;
+		bool gridInstancing{ true };
+		// Unit square and cube shared by every instanced grid.
+		struct PrimitiveMesh {
+			unsigned int vertexArray{ 0 };
+			unsigned int buffers[2]{ 0, 0 };
+			unsigned int indexCount{ 0 };
+		};
+		PrimitiveMesh gridMeshes[2];
+		RenderInterpolator renderInterpolator;
+		FrameCapture frameCapture;
+		bool pipelinedRendering{ false };
+
+		JobSystem jobSystem;
+		FrameArenas frameArenas;
+		FrameContext frameContext;
+		SystemScheduler systemScheduler;
+		AssetLoader assetLoader;
+		AssetWatcher assetWatcher;
+		std::vector<AssetReloadHandler> reloadHandlers;
+		std::vector<std::string> changedAssets;
+		LoadStats loadStats;
+		FrameStats updateTimes;
+		FrameStats frameTimes;
+		unsigned long long frameIndex{ 0 };
+		bool windowShown{ false };
 
-		Graphics::Renderer renderer;
+		bool parseScene(Scene::SceneManager& target, const std::string& sceneName, LoadStats& stats);
+		// Paths of the mesh and texture files a parsed scene names; relativeFiles gets them relative to the asset root.
+		std::vector<std::string> findSceneAssetFiles(Scene::SceneManager& target, std::vector<std::string>& relativeFiles);
+		size_t slotOf(const Scene::SceneManager& target) const { return &target == &sceneSlots[0] ? 0 : 1; }
+		// Context thread. A fresh ResourceManager and Renderer for target's slot, held by keep.
+		SceneGraphics* createSceneGraphics(Scene::SceneManager& target, ResourceList& keep);
+		// The ResourceManager loads for a parsed scene, split into context-thread
+		// steps of a few meshes or textures each so a preload can spread them over frames.
+		std::vector<AssetLoader::Upload> sceneResourceSteps(Scene::SceneManager& target, const std::string& sceneName, LoadStats& stats, ResourceList& keep);
+		// Context thread. Refills the batcher with the scene's grid cells; keep gets the mesh handles.
+		void batchSceneGrids(Scene::SceneManager& target, ResourceList& keep);
+		ResourceHandle acquireGridMesh(const bool cube);
+		void registerDefaultSystems(Scene::SceneManager& target);
+		void applyAssetChanges();
+		bool waitForFrame();
+		void postEmptyEvent() const { if (onDemandRendering) windowManager.postEmptyEvent(); }
+		// Loads the program from the binary cache, or compiles it through ShaderManager and caches it.
+		unsigned int buildProgram(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath, bool& fromCache);
+		// Writes engine-built shader source under the cache directory; the path, or empty on failure.
+		std::string writeGeneratedShader(const std::string& fileName, const std::string& source) const;
+		bool reloadShaderProgram();
+		// Derives the instanced program from the scene shaders; a failure keeps the previous one.
+		bool buildInstancedProgram();
+		void runOnContextThread(RenderThread::Callback command);
+		// Like runOnContextThread, but waits for the command and returns its result.
+		bool callOnContextThread(RenderThread::Call command);
+		void updateSimulation(const float deltaTime);
+		void stepSystems(const float deltaTime);
+		void renderFrame();
+		void presentFrame(const Clock::Ticks inputTimestamp);
 
-		void handleKeyEvents(const std::vector<KeyEvent>& keyEvents);
-		void handleButtonEvents(const std::vector<Input::MouseButtonEvent>& buttonEvents);
+		bool replayInputFrame(float& deltaTime);
+		void handleInputEvents(const InputEventSpan events);
+		void handleKeyEvent(const KeyEvent& event);
+		void handleEngineKey(const int key);
+		// ESC, F9 and F12 still work while a replay has live input shut off.
+		static bool isReplayControlKey(const int key);
+		void handleButtonEvent(const Input::MouseButtonEvent& event);
 	};
 }
\ No newline at end of file
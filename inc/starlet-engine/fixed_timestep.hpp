@@ -0,0 +1,28 @@
+#pragma once
+
+namespace Starlet::Engine {
+  // Accumulates variable frame time and hands out a whole number of fixed
+  // simulation steps per frame. Leftover time is exposed as an interpolation
+  // alpha in [0, 1) for rendering between the last two simulated states.
+  class FixedTimestep {
+  public:
+    FixedTimestep() = default;
+
+    void setTickRate(const double ticksPerSecond);
+    void setMaxSteps(const unsigned int steps) { maxSteps = steps > 0 ? steps : 1; }
+
+    unsigned int advance(const double frameDelta);
+    void reset() { accumulator = 0.0; alpha = 0.0f; }
+
+    float        getStep()     const { return static_cast<float>(step); }
+    double       getTickRate() const { return 1.0 / step; }
+    unsigned int getMaxSteps() const { return maxSteps; }
+    float        getAlpha()    const { return alpha; }
+
+  private:
+    double step{ 1.0 / 60.0 };
+    double accumulator{ 0.0 };
+    unsigned int maxSteps{ 5 };
+    float alpha{ 0.0f };
+  };
+}
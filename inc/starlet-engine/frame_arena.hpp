@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Debug builds poison reset memory so stale pointers into last frame's
+// scratch fail loudly. Force it on elsewhere with STARLET_ENGINE_ARENA_DEBUG.
+#if !defined(NDEBUG) || defined(STARLET_ENGINE_ARENA_DEBUG)
+#define STARLET_ARENA_DEBUG 1
+#else
+#define STARLET_ARENA_DEBUG 0
+#endif
+
+namespace Starlet::Engine {
+  // Bump allocator for memory that only lives until the end of the frame.
+  // Individual frees are no-ops; reset() releases everything at once. A frame
+  // that outgrows the block spills into overflow blocks, and the next reset()
+  // grows the main block to fit, so steady state never touches the heap.
+  class FrameArena {
+  public:
+    static constexpr unsigned char POISON = 0xCD;
+
+    explicit FrameArena(const size_t capacity = size_t{ 1 } << 20);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = default;
+    FrameArena& operator=(FrameArena&&) = default;
+
+    void* allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* allocateArray(const size_t count) { return static_cast<T*>(allocate(sizeof(T) * count, alignof(T))); }
+
+    void reset();
+
+    size_t getCapacity()      const { return capacity; }
+    size_t getUsed()          const { return used + overflowUsed; }
+    size_t getLastFrameUsed() const { return lastFrameUsed; }
+    size_t getHighWater()     const { return highWater; }
+
+  private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity{ 0 };
+    size_t used{ 0 };
+
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowUsed{ 0 };
+
+    size_t lastFrameUsed{ 0 };
+    size_t highWater{ 0 };
+  };
+
+  // std::pmr adapter so existing containers can opt in, e.g.
+  // std::pmr::vector<int> scratch(&resource);
+  class ArenaResource : public std::pmr::memory_resource {
+  public:
+    explicit ArenaResource(FrameArena& arena) : arena(arena) {}
+
+  private:
+    FrameArena& arena;
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override { return arena.allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+  };
+
+  // One arena per job-system thread, indexed by JobSystem::getCurrentThreadIndex(),
+  // so parallel jobs get scratch memory without synchronizing. Only the owner
+  // (main) thread and job workers have one; the render and loader threads
+  // must not allocate from frame arenas. The check holds in release builds:
+  // get() logs and aborts on any other index, and getResource() logs and
+  // falls back to the heap so pmr containers keep working.
+  class FrameArenas {
+  public:
+    FrameArenas(const unsigned int threadCount, const size_t capacityPerThread);
+
+    FrameArena& get(const unsigned int threadIndex);
+    std::pmr::memory_resource& getResource(const unsigned int threadIndex);
+
+    void reset();
+
+    size_t getLastFrameUsed() const;
+    size_t getHighWater() const;
+
+  private:
+    std::vector<FrameArena> arenas;
+    std::vector<std::unique_ptr<ArenaResource>> resources;
+  };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "starlet-engine/png_writer.hpp"
+#include "starlet-engine/thread_pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Starlet::Engine {
+  enum class CaptureFormat {
+    Raw, // frames appended to <directory>/capture.rgba (e.g. for ffmpeg -f rawvideo); each resize starts capture_<n>.rgba.
+         // A matching .txt sidecar records each file's width and height.
+    Png, // <directory>/frame_<index>.png
+    Sink // frames handed to CaptureSettings::sink only
+  };
+
+  // RGBA8 pixels, bottom row first as read back from GL. Valid only during the sink call.
+  struct CapturedFrame {
+    unsigned long long frameIndex{ 0 };
+    unsigned int width{ 0 };
+    unsigned int height{ 0 };
+    const unsigned char* pixels{ nullptr };
+  };
+
+  struct CaptureSettings {
+    CaptureFormat format{ CaptureFormat::Png };
+    std::string directory{ "." };
+    // Called on the capture worker for every frame, whatever the format.
+    std::function<void(const CapturedFrame&)> sink;
+    // Frames of readback kept in flight; a frame is read back this many frames late.
+    unsigned int latency{ 3 };
+    // Frames queued for encoding before new ones are dropped instead of stalling rendering.
+    unsigned int maxQueued{ 8 };
+    PngCompression pngCompression{ PngCompression::Fast };
+    // PNG files are independent, so Png captures without a sink encode on this
+    // many threads. Raw and sink captures keep one so frames stay in order.
+    unsigned int pngThreads{ 2 };
+  };
+
+  // Renders each frame into an offscreen FBO, blits it to the window, and
+  // starts an asynchronous readback into a ring of pixel buffer objects
+  // guarded by fences. A slot is mapped once its fence has signalled, so the
+  // GPU is never waited on unless the ring is full. Encoding and file I/O run
+  // on worker threads. All methods except isActive() and the stats run on
+  // the context thread.
+  class FrameCapture {
+  public:
+    FrameCapture() = default;
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    bool start(const CaptureSettings& settingsIn);
+    void stop();
+    bool isActive() const { return active; }
+
+    // endFrame() only records a frame that beginFrame() redirected into the capture target.
+    void beginFrame();
+    void endFrame(const unsigned long long frameIndex);
+
+    std::uint64_t getCapturedFrames() const { return captured; }
+    std::uint64_t getDroppedFrames() const { return dropped; }
+    std::uint64_t getStalls() const { return stalls; }
+
+  private:
+    struct Slot {
+      unsigned int buffer{ 0 };
+      void* fence{ nullptr };
+      unsigned long long frameIndex{ 0 };
+      bool pending{ false };
+    };
+
+    CaptureSettings settings;
+    std::atomic<bool> active{ false };
+    bool bound{ false };
+
+    unsigned int framebuffer{ 0 };
+    unsigned int colorBuffer{ 0 };
+    unsigned int depthBuffer{ 0 };
+    int previousFramebuffer{ 0 };
+    unsigned int width{ 0 };
+    unsigned int height{ 0 };
+
+    std::vector<Slot> slots;
+    size_t nextSlot{ 0 };
+    size_t oldestSlot{ 0 };
+
+    std::unique_ptr<ThreadPool> worker;
+    std::mutex poolMutex;
+    std::vector<std::vector<unsigned char>> freeBuffers;
+    std::atomic<unsigned int> queued{ 0 };
+    FILE* rawStream{ nullptr };
+    std::string rawPath;
+    unsigned int rawSegment{ 0 };
+
+    std::atomic<std::uint64_t> captured{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::uint64_t stalls{ 0 };
+
+    bool resize(const unsigned int widthIn, const unsigned int heightIn);
+    void releaseTargets();
+    void startRawSegment(const unsigned int segmentWidth, const unsigned int segmentHeight);
+    void writeRawSidecar(const unsigned int segmentWidth, const unsigned int segmentHeight);
+    void collect(const bool wait);
+    void readSlot(Slot& slot);
+    void encode(std::vector<unsigned char> pixels, const unsigned long long frameIndex, const unsigned int frameWidth, const unsigned int frameHeight);
+  };
+}
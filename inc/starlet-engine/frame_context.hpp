@@ -0,0 +1,26 @@
+#pragma once
+
+#include "starlet-engine/frame_arena.hpp"
+#include "starlet-engine/frame_demand.hpp"
+#include "starlet-engine/job_system.hpp"
+
+namespace Starlet::Engine {
+  // Per-frame state handed to scheduled systems. Arena memory is only valid
+  // until the next frame starts.
+  struct FrameContext {
+    unsigned long long frameIndex{ 0 };
+    float deltaTime{ 0.0f };
+    float interpolationAlpha{ 1.0f };
+
+    JobSystem* jobs{ nullptr };
+    FrameArenas* arenas{ nullptr };
+    FrameDemand* demand{ nullptr };
+
+    // Scratch arena of the calling thread; safe to use from inside jobs.
+    FrameArena& getArena() const { return arenas->get(jobs->getCurrentThreadIndex()); }
+    std::pmr::memory_resource& getResource() const { return arenas->getResource(jobs->getCurrentThreadIndex()); }
+    // Systems that changed what is on screen ask for another frame; only
+    // needed when the engine renders on demand.
+    void requestRedraw(const unsigned int frames = 1) const { if (demand) demand->markDirty(frames); }
+  };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "starlet-engine/clock.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace Starlet::Engine {
+  // Decides when an on-demand loop needs its next frame. Frames are owed for
+  // explicit requests (markDirty), timers (requestFrameAt), running
+  // animations and held keys or buttons. A minimised window owes nothing
+  // until it is restored, and an unfocused one is capped at the background
+  // rate. Requests are safe from any thread; the rest runs on the main thread.
+  class FrameDemand {
+  public:
+    void markDirty(const unsigned int frames = 1);
+    void requestFrameAt(const Clock::Ticks when);
+    void beginAnimation() { ++animations; }
+    void endAnimation();
+
+    // Keys and mouse buttons are tracked apart, since their codes overlap.
+    void setKeyHeld(const int key, const bool held) { setHeld(heldKeys, key, held); }
+    void setButtonHeld(const int button, const bool held) { setHeld(heldButtons, button, held); }
+    void setIconified(const bool iconifiedIn);
+    void setFocused(const bool focusedIn) { focused = focusedIn; }
+    // 0 leaves unfocused windows unthrottled.
+    void setBackgroundFrameRate(const double fps) { backgroundInterval = fps > 0.0 ? Clock::fromSeconds(1.0 / fps) : 0; }
+
+    bool isIconified() const { return iconified; }
+    bool isFocused() const { return focused; }
+    // True while animations or held input want every frame.
+    bool isContinuous() const { return animations.load() > 0 || !heldKeys.empty() || !heldButtons.empty(); }
+
+    // Seconds until the next frame is owed: 0 when one is due now, negative
+    // when nothing is pending and the caller may wait indefinitely.
+    double getWaitSeconds(const Clock::Ticks now) const;
+    // Called as a frame starts; requests made after this carry to the next frame.
+    void beginFrame(const Clock::Ticks now);
+
+  private:
+    std::atomic<unsigned int> pendingFrames{ 1 };
+    std::atomic<Clock::Ticks> deadline{ 0 }; // 0 = none
+    std::atomic<int> animations{ 0 };
+    std::vector<int> heldKeys;
+    std::vector<int> heldButtons;
+
+    bool iconified{ false };
+    bool focused{ true };
+    Clock::Ticks backgroundInterval{ Clock::fromSeconds(0.1) };
+    Clock::Ticks lastFrame{ 0 };
+
+    static void setHeld(std::vector<int>& held, const int code, const bool isHeld);
+  };
+}
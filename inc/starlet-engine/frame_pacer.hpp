@@ -0,0 +1,52 @@
+#pragma once
+
+#include "starlet-engine/clock.hpp"
+#include "starlet-engine/latency_histogram.hpp"
+
+#include <cstdint>
+
+namespace Starlet::Engine {
+  enum class PresentMode {
+    VSync,     // swap interval 1
+    Adaptive,  // swap interval -1 (late frames tear instead of waiting a full interval)
+    Uncapped,  // swap interval 0, no limiter; for benchmarking
+    Limited    // swap interval 0, hybrid sleep+spin limiter at the target rate
+  };
+
+  // Ends each frame: records frame intervals, counts missed deadlines and, in
+  // Limited mode, waits until the next deadline. Sleeping stops a margin
+  // short of the deadline and the rest is spun, because OS sleeps overshoot
+  // by up to a scheduler tick. The margin adapts to the observed overshoot.
+  class FramePacer {
+  public:
+    void setMode(const PresentMode modeIn, const double targetFps = 0.0);
+    void setRefreshRate(const double hz) { refreshRate = hz > 0.0 ? hz : 60.0; }
+
+    PresentMode getMode() const { return mode; }
+    int getSwapInterval() const;
+
+    void endFrame();
+    // Forgets the last frame's end, so a pause (such as an idle on-demand
+    // wait) is neither recorded as an interval nor counted as a miss.
+    void resetInterval();
+
+    const LatencyHistogram& getFrameTimes() const { return frameTimes; }
+    std::uint64_t getMissedDeadlines() const { return missedDeadlines; }
+    void resetStats();
+
+  private:
+    PresentMode mode{ PresentMode::VSync };
+    double refreshRate{ 60.0 };
+    Clock::Ticks period{ 0 };
+
+    Clock::Ticks lastFrameEnd{ 0 };
+    Clock::Ticks nextDeadline{ 0 };
+    Clock::Ticks spinMargin{ 2'000'000 };
+
+    LatencyHistogram frameTimes;
+    std::uint64_t missedDeadlines{ 0 };
+
+    void waitUntil(const Clock::Ticks deadline);
+    Clock::Ticks getExpectedInterval() const;
+  };
+}
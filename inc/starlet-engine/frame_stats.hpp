@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace Starlet::Engine {
+  // Rolling window of recent frame times. Percentiles are computed on request
+  // from a fixed scratch buffer, so recording never allocates.
+  class FrameStats {
+  public:
+    static constexpr size_t WINDOW = 256;
+
+    void record(const double milliseconds);
+    void clear() { count = 0; next = 0; }
+
+    size_t getCount() const { return count; }
+    double getPercentile(const double percentile) const;
+    double getAverage() const;
+
+    double getP50() const { return getPercentile(0.50); }
+    double getP99() const { return getPercentile(0.99); }
+
+  private:
+    std::array<double, WINDOW> samples{};
+    mutable std::array<double, WINDOW> scratch{};
+    size_t count{ 0 };
+    size_t next{ 0 };
+  };
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "starlet-engine/clock.hpp"
+#include "starlet-controls/input_manager.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Starlet::Engine {
+  enum class InputEventType : std::uint8_t {
+    Key,
+    MouseButton,
+    Scroll
+  };
+
+  struct InputEvent {
+    InputEventType type{ InputEventType::Key };
+    Clock::Ticks timestamp{ 0 };
+    KeyEvent key{};
+    Input::MouseButtonEvent button{};
+    Input::ScrollEvent scroll{};
+  };
+
+  struct InputEventSpan {
+    const InputEvent* data{ nullptr };
+    size_t size{ 0 };
+
+    const InputEvent* begin() const { return data; }
+    const InputEvent* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+  };
+
+  // Fixed-capacity single-producer/single-consumer ring filled from the GLFW
+  // callbacks. consume() moves everything pending into a frame buffer owned
+  // by the queue and returns it as a span, so steady state never allocates.
+  template<size_t Capacity>
+  class InputEventQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    bool push(const InputEvent& event) {
+      const std::uint64_t written = head.load(std::memory_order_relaxed);
+      if (written - tail.load(std::memory_order_acquire) >= Capacity) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      ring[written & (Capacity - 1)] = event;
+      head.store(written + 1, std::memory_order_release);
+      return true;
+    }
+
+    InputEventSpan consume() {
+      const std::uint64_t written = head.load(std::memory_order_acquire);
+      std::uint64_t read = tail.load(std::memory_order_relaxed);
+
+      size_t count = 0;
+      for (; read != written; ++read) frame[count++] = ring[read & (Capacity - 1)];
+      tail.store(read, std::memory_order_release);
+
+      return { frame.data(), count };
+    }
+
+    std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    std::array<InputEvent, Capacity> ring{};
+    std::array<InputEvent, Capacity> frame{};
+    std::atomic<std::uint64_t> head{ 0 };
+    std::atomic<std::uint64_t> tail{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+  };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "starlet-engine/input_event_queue.hpp"
+#include "starlet-engine/mapped_file.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Starlet::Engine {
+  // One simulated frame of a recorded session: the delta the timer produced,
+  // the cursor position after polling, and the input events in arrival order.
+  struct InputLogFrame {
+    float deltaTime{ 0.0f };
+    double cursorX{ 0.0 };
+    double cursorY{ 0.0 };
+    std::vector<InputEvent> events;
+  };
+
+  // Binary input log: a header recording the event struct sizes (logs from a
+  // build with different layouts are rejected), then per frame the delta,
+  // cursor position, event count and each event as a type byte plus the raw
+  // KeyEvent / MouseButtonEvent / ScrollEvent.
+  struct InputLogHeader {
+    std::uint32_t magic;
+    std::uint32_t formatVersion;
+    std::uint32_t keyEventSize;
+    std::uint32_t buttonEventSize;
+    std::uint32_t scrollEventSize;
+    std::uint32_t reserved;
+  };
+
+  class InputRecorder {
+  public:
+    static constexpr std::uint32_t MAGIC = 0x504E4953; // "SINP"
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    InputRecorder() = default;
+    ~InputRecorder() { close(); }
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void recordFrame(const float deltaTime, const double cursorX, const double cursorY, const InputEventSpan events);
+
+    std::uint64_t getFrameCount() const { return frames; }
+
+  private:
+    FILE* file{ nullptr };
+    std::uint64_t frames{ 0 };
+  };
+
+  class InputReplay {
+  public:
+    InputReplay() = default;
+    ~InputReplay() { close(); }
+
+    InputReplay(const InputReplay&) = delete;
+    InputReplay& operator=(const InputReplay&) = delete;
+
+    // timingPath, if set, receives one CSV row per replayed frame via recordTiming().
+    bool open(const std::string& path, const std::string& timingPath = "");
+    void close();
+    bool isOpen() const { return log.isOpen(); }
+
+    // False once the log is exhausted (or truncated).
+    bool next(InputLogFrame& frame);
+    void recordTiming(const double updateMs, const double frameMs);
+
+    std::uint64_t getFrameIndex() const { return frames; }
+
+  private:
+    MappedFile log;
+    size_t cursor{ 0 };
+    std::uint64_t frames{ 0 };
+    float lastDelta{ 0.0f };
+    FILE* timing{ nullptr };
+  };
+}
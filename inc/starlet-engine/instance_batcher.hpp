@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "starlet-engine/vertex_layout.hpp"
+
+namespace Starlet::Engine {
+  // What makes two instances drawable by one call: the same mesh (vertex
+  // array, index count and index type) with the same material texture and colour.
+  struct InstanceBatchKey {
+    static constexpr unsigned int UNSIGNED_INT_INDICES = 0x1405; // GL_UNSIGNED_INT
+    static constexpr std::uint32_t WHITE = 0xFFFFFFFFu;
+
+    unsigned int vertexArray{ 0 };
+    unsigned int indexCount{ 0 };
+    unsigned int texture{ 0 };
+    // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, as bound on the VAO.
+    unsigned int indexType{ UNSIGNED_INT_INDICES };
+    // RGBA8, red in the high byte; see packColour().
+    std::uint32_t colour{ WHITE };
+
+    bool operator==(const InstanceBatchKey& other) const {
+      return vertexArray == other.vertexArray && indexCount == other.indexCount && texture == other.texture && indexType == other.indexType
+        && colour == other.colour;
+    }
+  };
+
+  std::uint32_t packColour(const float r, const float g, const float b, const float a);
+
+  struct InstanceBatchKeyHash {
+    size_t operator()(const InstanceBatchKey& key) const {
+      return std::hash<std::uint64_t>()(((std::uint64_t{ key.vertexArray } << 32) ^ (std::uint64_t{ key.indexCount } << 16) ^ key.texture ^ (std::uint64_t{ key.indexType } << 48))
+        * 0x9E3779B97F4A7C15ull ^ key.colour);
+    }
+  };
+
+  // Valid until the batcher is cleared; a ref from before clear() is rejected.
+  struct InstanceRef {
+    std::uint32_t batch{ ~0u };
+    std::uint32_t slot{ ~0u };
+    std::uint32_t generation{ 0 };
+
+    bool isValid() const { return batch != ~0u; }
+  };
+
+  // Groups repeated mesh+material pairs into per-batch instance buffers of
+  // column-major model matrices and draws each batch with one instanced call,
+  // so submission cost scales with unique meshes rather than entities.
+  //
+  // setTransform() only marks the instance dirty; upload() then rewrites just
+  // the changed runs. Different instances may be updated from different jobs
+  // concurrently. upload() and draw() run on the context thread.
+  //
+  // With a fixed timestep, call beginStep() before each simulation step.
+  // An instance moved during the latest step is drawn blended between its
+  // transform before and after that step by the alpha given to upload(); the
+  // matrices are blended element-wise, which suits translation and small
+  // per-step rotations.
+  //
+  // Batches are drawn with their own program, which reads the matrix as a mat4
+  // attribute at getAttributeLocation(). The engine builds it from the scene's
+  // shaders, with the vertex stage's model uniform turned into that attribute
+  // by instancedVertexSource(). Before drawing, draw() copies every uniform
+  // the scene program holds (camera, lights, material) into it, then sets
+  // each batch's texture and colour under the names given to setMaterialUniforms().
+  class InstanceBatcher {
+  public:
+    static constexpr unsigned int DEFAULT_ATTRIBUTE_LOCATION = INSTANCE_MODEL_LOCATION;
+    // Empty if the source declares no "uniform mat4 <modelUniform>;".
+    static std::string instancedVertexSource(const std::string& sceneVertexSource, const std::string& modelUniform = "model",
+      const unsigned int location = DEFAULT_ATTRIBUTE_LOCATION);
+
+    InstanceBatcher() = default;
+    ~InstanceBatcher();
+
+    InstanceBatcher(const InstanceBatcher&) = delete;
+    InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+
+    void setAttributeLocation(const unsigned int location) { attributeLocation = location; }
+    unsigned int getAttributeLocation() const { return attributeLocation; }
+
+    // A program reading the matrix at getAttributeLocation(); its other
+    // uniforms are copied from the scene program by name.
+    void setProgram(const unsigned int instancedProgram);
+    unsigned int getProgram() const { return program; }
+    // Per-batch uniforms: a sampler for the key's texture, a bool saying
+    // whether there is one, and a vec3 or vec4 for the key's colour. An empty
+    // or missing name is skipped.
+    void setMaterialUniforms(std::string texture, std::string useTexture, std::string colour);
+
+    InstanceRef add(const InstanceBatchKey& key, const float* transform);
+    // False if the ref is out of range or from before the last clear().
+    bool setTransform(const InstanceRef instance, const float* transform);
+    // What upload(alpha) would draw for the instance; false for a bad ref.
+    bool getInterpolatedTransform(const InstanceRef instance, const float alpha, float* out) const;
+    void beginStep();
+    // Drops every instance and invalidates their refs; GL buffers are kept for reuse until destruction.
+    void clear();
+    bool empty() const { return instanceCount == 0; }
+
+    // alpha is the fixed timestep's leftover fraction; 1 draws the latest step as is.
+    void upload(const float alpha = 1.0f);
+    void draw(const unsigned int sceneProgram);
+
+    size_t getBatchCount() const { return batches.size(); }
+    size_t getInstanceCount() const { return instanceCount; }
+    // Calls issued by the last draw(), against the one-per-entity baseline.
+    size_t getDrawCalls() const { return drawCalls; }
+    size_t getEntityDrawCalls() const { return instanceCount; }
+    size_t getLastUploadBytes() const { return uploadBytes; }
+
+  private:
+    struct Batch {
+      InstanceBatchKey key;
+      std::vector<float> transforms;
+      // Each instance's transform before the step that last moved it, that
+      // step, and the matrices as last written to the GPU.
+      std::vector<float> previous;
+      std::vector<std::uint32_t> movedStep;
+      std::vector<float> rendered;
+      std::atomic<bool> anyMoving{ false };
+      std::unique_ptr<std::atomic<std::uint8_t>[]> dirty;
+      size_t dirtyCapacity{ 0 };
+      std::atomic<bool> anyDirty{ false };
+
+      unsigned int buffer{ 0 };
+      size_t bufferCapacity{ 0 };
+    };
+
+    // One scene program uniform and where it lives in the instanced program.
+    struct UniformCopy {
+      int from{ -1 };
+      int to{ -1 };
+      unsigned int type{ 0 };
+    };
+
+    std::vector<std::unique_ptr<Batch>> batches;
+    std::unordered_map<InstanceBatchKey, std::uint32_t, InstanceBatchKeyHash> batchIndex;
+    unsigned int attributeLocation{ DEFAULT_ATTRIBUTE_LOCATION };
+    unsigned int program{ 0 };
+    std::string textureUniform{ "diffuse" };
+    std::string useTextureUniform{ "useTexture" };
+    std::string colourUniform{ "colour" };
+    // Rebuilt whenever either program changes.
+    std::vector<UniformCopy> uniformCopies;
+    unsigned int copiedFrom{ 0 };
+    unsigned int copiedTo{ 0 };
+    int textureLocation{ -1 };
+    int useTextureLocation{ -1 };
+    int colourLocation{ -1 };
+    unsigned int colourType{ 0 };
+    std::uint32_t generation{ 0 };
+    std::uint32_t step{ 1 };
+    size_t instanceCount{ 0 };
+    size_t drawCalls{ 0 };
+    size_t uploadBytes{ 0 };
+
+    static void growDirty(Batch& batch, const size_t count);
+    void uploadBatch(Batch& batch, const float alpha);
+    void blend(const Batch& batch, const size_t slot, const float alpha, float* out) const;
+    void mapUniforms(const unsigned int sceneProgram);
+    void copyUniforms() const;
+  };
+}
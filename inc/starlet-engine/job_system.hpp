@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Starlet::Engine {
+  class JobCounter {
+  public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+    std::atomic<size_t> pending{ 0 };
+  };
+
+  // CPU job system with one deque per thread. Owners push and pop at the back;
+  // idle threads steal from the front of other deques. The owner thread and
+  // workers that wait on a counter run queued jobs until none are left, then
+  // sleep until it completes, so nested parallelFor calls cannot deadlock.
+  // Any other thread may submit and wait but never runs jobs itself.
+  // Blocking I/O belongs on AssetLoader's pool instead.
+  class JobSystem {
+  public:
+    using Job = std::function<void()>;
+
+    // One worker per hardware thread, minus the thread that owns the system.
+    static constexpr unsigned int HARDWARE = ~0u;
+    // Index reported to threads that are neither the owner nor a worker.
+    static constexpr unsigned int FOREIGN = ~0u;
+
+    explicit JobSystem(unsigned int workerCount = HARDWARE);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(Job job, JobCounter* counter = nullptr);
+    void wait(const JobCounter& counter);
+
+    // Splits [0, count) into ranges of at most grain items and calls
+    // fn(begin, end) for each across all threads, returning when all finish.
+    template<typename Fn>
+    void parallelFor(const size_t count, size_t grain, Fn&& fn);
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+    unsigned int getThreadCount() const { return getWorkerCount() + 1; }
+
+    // The owner starts as the constructing thread; rebind it when the loop
+    // runs elsewhere. Must not change while jobs are in flight.
+    void setOwnerThread() { ownerThread = std::this_thread::get_id(); }
+
+    // 0 for the owner thread, 1..N for workers, FOREIGN for anything else.
+    unsigned int getCurrentThreadIndex() const;
+
+  private:
+    struct Entry {
+      Job job;
+      JobCounter* counter{ nullptr };
+    };
+    struct Queue {
+      std::mutex mutex;
+      std::deque<Entry> entries;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::thread::id> ownerThread{ std::this_thread::get_id() };
+
+    std::atomic<size_t> queued{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::mutex sleepMutex;
+    // Workers and helping waiters sleep on wake; foreign waiters on finished,
+    // so a submit's single notification always reaches a thread that runs jobs.
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    bool tryRunOne(const unsigned int self);
+    void complete(JobCounter& counter);
+    void workerLoop(const unsigned int index);
+  };
+
+  template<typename Fn>
+  void JobSystem::parallelFor(const size_t count, size_t grain, Fn&& fn) {
+    if (count == 0) return;
+    if (grain == 0) grain = std::max<size_t>(1, count / (static_cast<size_t>(getThreadCount()) * 4));
+    if (count <= grain || workers.empty()) {
+      fn(size_t{ 0 }, count);
+      return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = grain; begin < count; begin += grain) {
+      const size_t end = std::min(count, begin + grain);
+      submit([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+
+    fn(size_t{ 0 }, grain);
+    wait(counter);
+  }
+}
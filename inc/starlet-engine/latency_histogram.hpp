@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Starlet::Engine {
+  // Fixed-bucket histogram of latencies in milliseconds. Recording is
+  // lock-free so it can happen on the render thread while another thread reads.
+  class LatencyHistogram {
+  public:
+    static constexpr std::array<double, 12> BUCKET_LIMITS_MS{ 1.0, 2.0, 4.0, 8.0, 12.0, 16.7, 20.0, 25.0, 33.3, 50.0, 66.7, 100.0 };
+    static constexpr size_t BUCKET_COUNT = BUCKET_LIMITS_MS.size() + 1;
+
+    void record(const double milliseconds);
+    void clear();
+
+    std::uint64_t getCount() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t getBucket(const size_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+    double getMaxMilliseconds() const { return static_cast<double>(maxMicros.load(std::memory_order_relaxed)) / 1000.0; }
+
+    // Upper bucket limit containing the given percentile; 0 when empty.
+    double getPercentileUpperBound(const double percentile) const;
+
+    std::string toString() const;
+
+  private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> total{ 0 };
+    std::atomic<std::uint64_t> maxMicros{ 0 };
+  };
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Starlet::Engine {
+  struct LoadStage {
+    std::string name;
+    double seconds{ 0.0 };
+  };
+
+  class LoadStats {
+  public:
+    void clear() { stages.clear(); }
+    // A stage recorded again (e.g. once per upload step) accumulates into its first entry.
+    void record(const std::string& name, const double seconds);
+
+    const std::vector<LoadStage>& getStages() const { return stages; }
+    double getTotalSeconds() const;
+
+    std::string toString() const;
+
+  private:
+    std::vector<LoadStage> stages;
+  };
+
+  class ScopedLoadStage {
+  public:
+    ScopedLoadStage(LoadStats& stats, const char* name) : stats(stats), name(name), start(std::chrono::steady_clock::now()) {}
+    ~ScopedLoadStage() { stats.record(name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+
+    ScopedLoadStage(const ScopedLoadStage&) = delete;
+    ScopedLoadStage& operator=(const ScopedLoadStage&) = delete;
+
+  private:
+    LoadStats& stats;
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+  };
+}
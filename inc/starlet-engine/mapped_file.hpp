@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Starlet::Engine {
+  // Read-only memory mapping of a whole file. The mapping lives as long as
+  // the object, so views into data() must not outlive it.
+  class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(view); }
+    size_t size() const { return length; }
+    bool isOpen() const { return view != nullptr; }
+
+  private:
+    void* view{ nullptr };
+    size_t length{ 0 };
+#ifdef _WIN32
+    void* fileHandle{ nullptr };
+    void* mappingHandle{ nullptr };
+#endif
+  };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+namespace Starlet::Engine {
+  enum class PngCompression {
+    Stored, // uncompressed deflate blocks: a copy plus checksums
+    Fast    // single-probe LZ77 with fixed Huffman codes, falling back to stored when that is larger
+  };
+
+  // Writes 8-bit RGBA as a PNG, with the Up filter on every scanline. Fast
+  // compression is meant to keep up with per-frame capture, not to match a
+  // full encoder's ratio. bottomUp flips rows, for pixels read back from GL.
+  bool writePng(const std::string& path, const unsigned int width, const unsigned int height, const unsigned char* rgba, const bool bottomUp,
+    const PngCompression compression = PngCompression::Fast);
+}
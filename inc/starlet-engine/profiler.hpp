@@ -0,0 +1,119 @@
+#pragma once
+
+#include "starlet-engine/clock.hpp"
+#include "starlet-engine/frame_stats.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Zones are compiled in for debug builds, or for any build configured with
+// STARLET_ENGINE_PROFILE. Otherwise every macro expands to nothing.
+#if !defined(NDEBUG) || defined(STARLET_ENGINE_PROFILE)
+#define STARLET_PROFILER_ENABLED 1
+#else
+#define STARLET_PROFILER_ENABLED 0
+#endif
+
+namespace Starlet::Engine {
+  struct ProfileEvent {
+    const char* name{ nullptr };
+    Clock::Ticks start{ 0 };
+    Clock::Ticks end{ 0 };
+    std::uint32_t threadId{ 0 };
+  };
+
+  // Single-producer/single-consumer ring owned by one thread. The owning
+  // thread writes zones; Profiler::collect() drains it from the frame thread.
+  class ProfileBuffer {
+  public:
+    static constexpr size_t CAPACITY = 1u << 14;
+
+    explicit ProfileBuffer(const std::uint32_t threadId) : threadId(threadId) {}
+
+    void push(const char* name, const Clock::Ticks start, const Clock::Ticks end);
+
+    template<typename Fn>
+    void drain(Fn&& fn) {
+      const std::uint64_t written = head.load(std::memory_order_acquire);
+      std::uint64_t read = tail.load(std::memory_order_relaxed);
+      for (; read != written; ++read) fn(events[read & (CAPACITY - 1)]);
+      tail.store(read, std::memory_order_release);
+    }
+
+    std::uint32_t getThreadId() const { return threadId; }
+    std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    ProfileEvent events[CAPACITY];
+    std::atomic<std::uint64_t> head{ 0 };
+    std::atomic<std::uint64_t> tail{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+    const std::uint32_t threadId;
+  };
+
+  class Profiler {
+  public:
+    static Profiler& get();
+
+    void record(const char* name, const Clock::Ticks start, const Clock::Ticks end);
+    void endFrame();
+
+    // Stable copy of a runtime name for zones, which store only the pointer.
+    // Interned names live as long as the profiler; quotes and backslashes
+    // become '_' so the trace stays valid JSON.
+    const char* intern(const std::string& name);
+
+    void beginCapture();
+    bool endCapture(const std::string& path);
+    bool isCapturing() const { return capturing; }
+
+    const FrameStats& getFrameStats() const { return frameStats; }
+
+  private:
+    Profiler() = default;
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ProfileBuffer>> buffers;
+
+    std::mutex namesMutex;
+    std::unordered_set<std::string> names;
+
+    std::vector<ProfileEvent> captured;
+    bool capturing{ false };
+
+    FrameStats frameStats;
+    Clock::Ticks lastFrameEnd{ 0 };
+
+    ProfileBuffer& threadBuffer();
+    void collect();
+  };
+
+  class ProfileZone {
+  public:
+    explicit ProfileZone(const char* name) : name(name), start(Clock::now()) {}
+    ~ProfileZone() { Profiler::get().record(name, start, Clock::now()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+  private:
+    const char* name;
+    Clock::Ticks start;
+  };
+}
+
+#if STARLET_PROFILER_ENABLED
+#define STARLET_PROFILE_CONCAT_INNER(a, b) a##b
+#define STARLET_PROFILE_CONCAT(a, b) STARLET_PROFILE_CONCAT_INNER(a, b)
+// name must be a string literal or come from Profiler::intern(); only the pointer is stored.
+#define STARLET_PROFILE_ZONE(name) ::Starlet::Engine::ProfileZone STARLET_PROFILE_CONCAT(starletProfileZone, __LINE__)(name)
+#define STARLET_PROFILE_FRAME() ::Starlet::Engine::Profiler::get().endFrame()
+#else
+#define STARLET_PROFILE_ZONE(name) ((void)0)
+#define STARLET_PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Starlet::Engine {
+  // Caches linked shader binaries and owns the engine's named programs.
+  // Binaries live in <dir>/<name>.pbin, keyed by the content hash of the
+  // shader sources and the driver that produced them; a binary the driver
+  // rejects is deleted so the next start compiles from source and rewrites
+  // it. Compiling is left to the caller (starlet-graphics' ShaderManager in
+  // the engine). Programs from the cache and from source are registered
+  // under the same name.
+  class ProgramCache {
+  public:
+    static constexpr std::uint32_t MAGIC = 0x47525053; // "SPRG"
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    ProgramCache() = default;
+    ~ProgramCache();
+
+    ProgramCache(const ProgramCache&) = delete;
+    ProgramCache& operator=(const ProgramCache&) = delete;
+
+    void setDirectory(const std::string& path) { directory = path; }
+    void setDriverId(const std::string& id) { driverId = id; }
+
+    // Requires a current context. False when the driver exposes no binary formats.
+    bool isSupported() const;
+
+    std::string cachePathFor(const std::string& name) const;
+
+    // Returns a linked program, or 0 on failure.
+    using Compile = std::function<unsigned int()>;
+
+    // Loads the cached binary for sourcePaths, or calls compile on a miss and
+    // caches what it links. The program is not registered; 0 on failure.
+    unsigned int build(const std::string& name, const std::vector<std::string>& sourcePaths, const Compile& compile, bool& fromCache);
+
+    // Returns a linked program from the cache, or 0 on a miss or rejected binary.
+    unsigned int load(const std::string& name, const std::vector<std::string>& sourcePaths);
+    bool store(const std::string& name, const unsigned int program, const std::vector<std::string>& sourcePaths) const;
+
+    // Takes ownership of program under name, deleting whatever was registered there before.
+    void registerProgram(const std::string& name, const unsigned int program);
+    // 0 if nothing is registered under name.
+    unsigned int getProgram(const std::string& name) const;
+
+  private:
+    struct Header {
+      std::uint32_t magic;
+      std::uint32_t formatVersion;
+      std::uint32_t binaryFormat;
+      std::uint32_t reserved;
+      std::uint64_t key;
+      std::uint64_t payloadSize;
+    };
+
+    std::string directory;
+    std::string driverId;
+    std::unordered_map<std::string, unsigned int> programs;
+
+    bool computeKey(const std::vector<std::string>& sourcePaths, std::uint64_t& key) const;
+  };
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "starlet-engine/clock.hpp"
+#include "starlet-engine/frame_stats.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace Starlet::Engine {
+  // Owns the GL context on a dedicated thread. Each submitted frame runs
+  // render() and then present(). submitFrame() returns as soon as render()
+  // is done reading the scene. The caller can then simulate the next frame
+  // while present() waits on vsync. At most one frame is ever in flight, so
+  // the added latency is capped at one frame and tracked in getLatency().
+  class RenderThread {
+  public:
+    using Callback = std::function<void()>;
+    using PresentCallback = std::function<void(const Clock::Ticks inputTimestamp)>;
+    using Call = std::function<bool()>;
+
+    RenderThread() = default;
+    ~RenderThread() { stop(); }
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    bool start(GLFWwindow* window, Callback render, PresentCallback present);
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    // GL state changes issued from the simulation thread, run before the next render.
+    void enqueue(Callback command);
+    // Runs command on the render thread as soon as it is between frames,
+    // after anything already enqueued, and returns its result. The caller
+    // blocks until then, so the command may touch simulation state. Not for
+    // use from the render thread itself.
+    bool call(Call command);
+    bool isRenderThread() const { return std::this_thread::get_id() == thread.get_id(); }
+
+    // inputTimestamp is the oldest input shown by this frame (0 if none) and is
+    // handed to present() so input-to-photon latency can be measured there.
+    void submitFrame(const Clock::Ticks inputTimestamp = 0);
+
+    FrameStats getLatency() const;
+
+  private:
+    std::thread thread;
+    GLFWwindow* window{ nullptr };
+    Callback render;
+    PresentCallback present;
+
+    mutable std::mutex mutex;
+    std::condition_variable signal;
+    std::vector<Callback> commands;
+    std::vector<Callback> executing;
+    Call pendingCall;
+    bool callDone{ false };
+    bool callResult{ false };
+
+    bool frameQueued{ false };
+    bool sceneReleased{ true };
+    bool presenting{ false };
+    bool stopping{ false };
+    Clock::Ticks submittedAt{ 0 };
+    Clock::Ticks submittedInput{ 0 };
+    FrameStats latency;
+
+    void runCommands();
+    void threadLoop();
+  };
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Starlet::Engine {
+  using ResourceKey = std::uint64_t;
+
+  // GPU resources shared between scenes, keyed by the content of their source
+  // so two scenes naming the same file (or identical copies of it) share one
+  // upload. Handles are reference counts; an entry whose last handle is gone
+  // stays resident until collect() runs its release on the context thread.
+  class ResourceRegistry {
+    struct Entry {
+      std::function<void()> release;
+      size_t bytes{ 0 };
+      std::atomic<unsigned int> references{ 0 };
+    };
+
+  public:
+    using Release = std::function<void()>;
+
+    class Handle {
+    public:
+      Handle() = default;
+      Handle(const Handle& other) : entry(other.entry), key(other.key) { if (entry) ++entry->references; }
+      Handle(Handle&& other) noexcept : entry(other.entry), key(other.key) { other.entry = nullptr; }
+      Handle& operator=(Handle other) noexcept {
+        std::swap(entry, other.entry);
+        std::swap(key, other.key);
+        return *this;
+      }
+      ~Handle() { if (entry) --entry->references; }
+
+      bool isValid() const { return entry != nullptr; }
+      explicit operator bool() const { return isValid(); }
+      ResourceKey getKey() const { return key; }
+
+    private:
+      friend class ResourceRegistry;
+      Handle(Entry* entry, const ResourceKey key) : entry(entry), key(key) { ++entry->references; }
+
+      Entry* entry{ nullptr };
+      ResourceKey key{ 0 };
+    };
+
+    // Handles must not outlive the registry.
+    ResourceRegistry() = default;
+    ~ResourceRegistry();
+
+    ResourceRegistry(const ResourceRegistry&) = delete;
+    ResourceRegistry& operator=(const ResourceRegistry&) = delete;
+
+    // Key for a file's content, salted with the resource type so a mesh and a
+    // texture decoded from the same bytes do not collide. 0 if unreadable.
+    static ResourceKey keyForFile(const std::string& path, const std::string& type);
+
+    // Safe from any thread. Invalid handle if the key is not resident.
+    Handle acquire(const ResourceKey key);
+    // Context thread. Registers a freshly uploaded resource; if the key is
+    // already resident the new copy is released and the existing one shared.
+    Handle insert(const ResourceKey key, Release release, const size_t bytes = 0);
+    bool isResident(const ResourceKey key) const;
+
+    // Context thread. Releases every unreferenced entry; returns how many.
+    size_t collect();
+
+    size_t getResidentCount() const;
+    size_t getResidentBytes() const;
+
+  private:
+    mutable std::mutex mutex;
+    std::unordered_map<ResourceKey, std::unique_ptr<Entry>> entries;
+    size_t residentBytes{ 0 };
+  };
+
+  using ResourceHandle = ResourceRegistry::Handle;
+  using ResourceList = std::vector<ResourceHandle>;
+}
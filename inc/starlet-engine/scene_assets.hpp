@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Starlet::Engine {
+  // Regular files under an asset root, looked up the two ways scene files name
+  // them: by path relative to the root or by bare file name. Built once and
+  // reused across scene loads; clear it when files are added so the next
+  // build() picks them up.
+  class AssetIndex {
+  public:
+    // Directories listed in excluded (relative to the root) are not searched.
+    void build(const std::string& root, const std::vector<std::string>& excluded = {});
+    void clear() { files.clear(); }
+    bool empty() const { return files.empty(); }
+    bool contains(const std::string& name) const;
+
+    // Paths (joined onto the root) of the files names refer to, once each, in
+    // the order they first appear. Names matching no file are skipped.
+    std::vector<std::string> resolve(const std::vector<std::string>& names) const;
+
+  private:
+    std::unordered_map<std::string, std::string> files;
+  };
+
+  // Faults a file into the OS page cache so a later synchronous read of it
+  // does not wait on the disk. Returns false if it cannot be opened.
+  bool prefetchFile(const std::string& path);
+}
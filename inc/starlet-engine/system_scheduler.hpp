@@ -0,0 +1,56 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace Starlet::Engine {
+  class JobSystem;
+  struct FrameContext;
+
+  // Component types a system reads and writes. Two systems conflict when one
+  // writes a type the other reads or writes.
+  struct SystemAccess {
+    std::vector<std::type_index> reads;
+    std::vector<std::type_index> writes;
+
+    template<typename T> SystemAccess& read()  { reads.emplace_back(typeid(T));  return *this; }
+    template<typename T> SystemAccess& write() { writes.emplace_back(typeid(T)); return *this; }
+
+    bool conflictsWith(const SystemAccess& other) const;
+  };
+
+  // Runs registered systems in phases. Each system is placed in the first
+  // phase after every earlier-registered system it conflicts with, so
+  // conflicting systems keep registration order and the rest run concurrently.
+  class SystemScheduler {
+  public:
+    // Returns true when the system changed something on screen.
+    using Update = std::function<bool(const FrameContext& frame)>;
+
+    void add(const std::string& name, SystemAccess access, Update update);
+    void clear();
+
+    // True if any system reported a change.
+    bool run(JobSystem& jobs, const FrameContext& frame);
+
+    size_t getSystemCount() const { return systems.size(); }
+    size_t getPhaseCount() { buildPhases(); return phases.size(); }
+
+  private:
+    struct Entry {
+      std::string name;
+      // Interned in add() so each system's profiler zone carries its name.
+      const char* zoneName;
+      SystemAccess access;
+      Update update;
+    };
+
+    std::vector<Entry> systems;
+    std::vector<std::vector<size_t>> phases;
+    bool phasesDirty{ false };
+
+    void buildPhases();
+  };
+}
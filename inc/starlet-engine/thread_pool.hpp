@@ -0,0 +1,36 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Starlet::Engine {
+  class ThreadPool {
+  public:
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void waitIdle();
+
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+  private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable idle;
+    unsigned int active{ 0 };
+    bool stopping{ false };
+
+    void workerLoop();
+  };
+}
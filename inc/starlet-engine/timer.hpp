@@ -1,13 +1,18 @@
 #pragma once
 
+#include "starlet-engine/clock.hpp"
+
 namespace Starlet::Engine {
 	class Timer {
 	public:
-		Timer();
+		Timer() = default;
 
 		float tick();
 
+		double getElapsedSeconds() const { return startTicks == 0 ? 0.0 : Clock::toSeconds(Clock::now() - startTicks); }
+
 	private:
-		float lastTime;
+		Clock::Ticks startTicks{ 0 };
+		Clock::Ticks lastTicks{ 0 };
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace Starlet::Engine {
+  // Bounded hand-off from loader threads to the thread owning the GL context.
+  // Producers block while the queue is full so decoded data cannot pile up
+  // faster than the context thread uploads it.
+  class UploadQueue {
+  public:
+    using Upload = std::function<bool()>;
+
+    explicit UploadQueue(const size_t capacity = 64) : capacity(capacity > 0 ? capacity : 1) {}
+
+    void push(Upload upload);
+
+    bool tryPop(Upload& out);
+    bool waitPop(Upload& out);
+
+    size_t getCapacity() const { return capacity; }
+
+  private:
+    std::deque<Upload> uploads;
+    const size_t capacity;
+
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+  };
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Starlet::Engine {
+  // Attribute locations shared by the meshes the engine uploads and the
+  // shaders that read them; they follow the scene shaders' layout, so a
+  // cooked or instanced mesh is read the same way as one the renderer loads.
+  enum VertexLocation : unsigned int {
+    POSITION_LOCATION = 0,       // vec3
+    NORMAL_LOCATION = 1,         // vec3
+    TEXCOORD_LOCATION = 2,       // vec2
+    COLOR_LOCATION = 3,          // vec4
+    INSTANCE_MODEL_LOCATION = 8  // mat4, four consecutive locations
+  };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 struct GLFWwindow;
 
 namespace Starlet {
@@ -13,16 +15,21 @@ namespace Starlet {
 			Window() = default;
 			~Window();
 
-			bool createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title);
+			bool createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title, const bool withContext = true);
 
 			GLFWwindow* getGLFWwindow() const { return window; }
+			bool hasContext() const { return window && contextCreated; }
 			bool shouldClose() const;
 
-			unsigned int getWidth()  const { return width; }
-			unsigned int getHeight() const { return height; }
-			float        getAspect() const { return static_cast<float>(width) / static_cast<float>(height); }
+			unsigned int getWidth()  const { return unpackWidth(size.load(std::memory_order_relaxed)); }
+			unsigned int getHeight() const { return unpackHeight(size.load(std::memory_order_relaxed)); }
+			// A minimised window reports zero height; fall back to square rather than divide by it.
+			float        getAspect() const;
 
 			void pollEvents() const;
+			// Blocks until an event arrives or the timeout passes; negative waits indefinitely.
+			void waitEvents(const double timeoutSeconds) const;
+			void postEmptyEvent() const;
 			void swapBuffers() const;
 			void requestClose() const;
 
@@ -36,7 +43,15 @@ namespace Starlet {
 
 		private:
 			GLFWwindow* window{ nullptr };
-			unsigned int width{ 0 }, height{ 0 };
+			// Width and height packed into one atomic: resizes are written on the
+			// context thread and read from any thread, and an aspect ratio must
+			// never mix the old width with the new height.
+			std::atomic<unsigned long long> size{ 0 };
+			bool contextCreated{ false };
+
+			static unsigned long long packSize(const unsigned int width, const unsigned int height) { return (static_cast<unsigned long long>(width) << 32) | height; }
+			static unsigned int unpackWidth(const unsigned long long packed)  { return static_cast<unsigned int>(packed >> 32); }
+			static unsigned int unpackHeight(const unsigned long long packed) { return static_cast<unsigned int>(packed & 0xFFFFFFFFull); }
 		};
 	}
 }
\ No newline at end of file
@@ -2,8 +2,18 @@
 
 #include "window.hpp"
 #include <memory>
+#include <string>
 
 namespace Starlet::Engine {
+  // Display opens a real on-screen window. Offscreen uses GLFW's null platform
+  // with an OSMesa software context, and Null uses the null platform with no
+  // GL context at all; both run on hosts without a display or GPU.
+  enum class WindowBackend {
+    Display,
+    Offscreen,
+    Null
+  };
+
   class WindowManager {
   public:
     WindowManager();
@@ -12,12 +22,28 @@ namespace Starlet::Engine {
     GLFWwindow* getGLFWwindow() const { return activeWindow ? activeWindow->getGLFWwindow() : nullptr; }
     unsigned int getWidth()      const { return activeWindow ? activeWindow->getWidth() : 0; }
     unsigned int getHeight()     const { return activeWindow ? activeWindow->getHeight() : 0; }
-    float        getAspect()     const { return activeWindow ? static_cast<float>(activeWindow->getWidth()) / static_cast<float>(activeWindow->getHeight()) : -1.0f; }
+    float        getAspect()     const { return activeWindow ? activeWindow->getAspect() : -1.0f; }
+
+    void setBackend(const WindowBackend backendIn) { backend = backendIn; }
+    WindowBackend getBackend() const { return backend; }
+    bool hasContext() const { return activeWindow && activeWindow->hasContext(); }
+    // "vendor|renderer|version" of the current context, empty without one.
+    const std::string& getDriverId() const { return driverId; }
 
     bool createWindow(const unsigned int width, const unsigned int height, const char* title);
+
+    // Must be called on the thread that owns the context. -1 (adaptive) falls
+    // back to 1 when the driver lacks swap_control_tear.
+    void setSwapInterval(const int interval);
+    int getSwapInterval() const { return swapInterval; }
+    double getRefreshRate() const;
     bool shouldClose() const { return activeWindow ? activeWindow->shouldClose() : true; }
 
     void pollEvents()   const { if (activeWindow) activeWindow->pollEvents(); }
+    // The null platform has no event source to block on, so headless backends sleep instead.
+    void waitEvents(const double timeoutSeconds) const;
+    // Wakes waitEvents from any thread.
+    void postEmptyEvent() const { if (activeWindow && backend == WindowBackend::Display) activeWindow->postEmptyEvent(); }
     void swapBuffers()  const { if (activeWindow) activeWindow->swapBuffers(); }
     void requestClose() const { if (activeWindow) activeWindow->requestClose(); }
 
@@ -30,5 +56,12 @@ namespace Starlet::Engine {
 
   private:
     std::unique_ptr<Window> activeWindow;
+    WindowBackend backend{ WindowBackend::Display };
+    int swapInterval{ 1 };
+    std::string driverId;
+    bool glfwReady{ false };
+
+    bool initGLFW();
+    bool createContextWindow(const unsigned int width, const unsigned int height, const char* title, const bool withContext);
   };
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "starlet-engine/asset_loader.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include "starlet-engine/clock.hpp"
+
+#include <string>
+
+namespace Starlet::Engine {
+  AssetLoader::AssetLoader(const unsigned int threadCount, const size_t queueCapacity)
+    : uploads(queueCapacity), pool(threadCount) {}
+  AssetLoader::~AssetLoader() {
+    // Discard anything never drained so workers blocked on a full queue can exit.
+    for (; submitted > 0; --submitted) {
+      Upload upload;
+      uploads.waitPop(upload);
+    }
+  }
+
+  AssetLoader::Batch AssetLoader::createBatch() {
+    std::lock_guard<std::mutex> lock(batchMutex);
+    const Batch batch = nextBatch++;
+    if (nextBatch == NO_BATCH) ++nextBatch;
+    batches[batch] = BatchState{};
+    return batch;
+  }
+
+  void AssetLoader::enqueue(Decode decode, const Batch batch) {
+    if (batch != NO_BATCH) {
+      std::lock_guard<std::mutex> lock(batchMutex);
+      ++batches[batch].pending;
+    }
+
+    ++submitted;
+    pool.submit([this, batch, decode = std::move(decode)] {
+      Upload upload = decode();
+      if (!upload) upload = [] { return false; };
+      if (batch == NO_BATCH) {
+        uploads.push(std::move(upload));
+        return;
+      }
+
+      // The batch is settled when its upload is applied, not when decoding ends.
+      uploads.push([this, batch, upload = std::move(upload)] {
+        const bool ok = upload();
+        std::lock_guard<std::mutex> lock(batchMutex);
+        BatchState& state = batches[batch];
+        --state.pending;
+        if (!ok) ++state.failed;
+        return ok;
+      });
+    });
+  }
+
+  void AssetLoader::enqueueSteps(StepDecode decode) {
+    ++submitted;
+    pool.submit([this, decode = std::move(decode)] {
+      std::vector<Upload> steps = decode();
+      if (steps.empty()) steps.push_back([] { return false; });
+
+      // Counted before the first push so finish() keeps draining until the last step.
+      submitted += steps.size() - 1;
+      for (Upload& step : steps) uploads.push(step ? std::move(step) : Upload([] { return false; }));
+    });
+  }
+
+  void AssetLoader::run(std::function<bool()> task, const Batch batch) {
+    {
+      std::lock_guard<std::mutex> lock(batchMutex);
+      ++batches[batch].pending;
+    }
+
+    pool.submit([this, batch, task = std::move(task)] {
+      const bool ok = task();
+      {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        BatchState& state = batches[batch];
+        --state.pending;
+        if (!ok) ++state.failed;
+      }
+      batchSettled.notify_all();
+    });
+  }
+
+  bool AssetLoader::apply(Upload& upload) {
+    --submitted;
+    return upload();
+  }
+
+  bool AssetLoader::finish() {
+    size_t failed = 0;
+    while (submitted > 0) {
+      Upload upload;
+      uploads.waitPop(upload);
+      if (!apply(upload)) ++failed;
+    }
+
+    if (failed > 0) return Logger::error("AssetLoader", "finish", std::to_string(failed) + " asset(s) failed to load");
+    return true;
+  }
+
+  bool AssetLoader::finish(const Batch batch) {
+    while (getPending(batch) > 0) {
+      Upload upload;
+      uploads.waitPop(upload);
+      if (!apply(upload)) Logger::error("AssetLoader", "finish", "Asset failed to upload");
+    }
+
+    size_t failed = 0;
+    {
+      std::lock_guard<std::mutex> lock(batchMutex);
+      const auto it = batches.find(batch);
+      if (it != batches.end()) {
+        failed = it->second.failed;
+        batches.erase(it);
+      }
+    }
+
+    if (failed > 0) return Logger::error("AssetLoader", "finish", std::to_string(failed) + " asset(s) in batch failed to load");
+    return true;
+  }
+
+  bool AssetLoader::wait(const Batch batch) {
+    size_t failed = 0;
+    {
+      std::unique_lock<std::mutex> lock(batchMutex);
+      batchSettled.wait(lock, [this, batch] {
+        const auto it = batches.find(batch);
+        return it == batches.end() || it->second.pending == 0;
+      });
+      const auto it = batches.find(batch);
+      if (it != batches.end()) {
+        failed = it->second.failed;
+        batches.erase(it);
+      }
+    }
+
+    if (failed > 0) return Logger::error("AssetLoader", "wait", std::to_string(failed) + " task(s) in batch failed");
+    return true;
+  }
+
+  size_t AssetLoader::getPending(const Batch batch) const {
+    std::lock_guard<std::mutex> lock(batchMutex);
+    const auto it = batches.find(batch);
+    return it != batches.end() ? it->second.pending : 0;
+  }
+
+  size_t AssetLoader::pump(const double budgetMs) {
+    const Clock::Ticks deadline = budgetMs > 0.0 ? Clock::now() + Clock::fromSeconds(budgetMs / 1000.0) : 0;
+    size_t applied = 0;
+    Upload upload;
+    while (submitted > 0 && uploads.tryPop(upload)) {
+      ++applied;
+      if (!apply(upload)) Logger::error("AssetLoader", "pump", "Asset failed to upload");
+      if (deadline != 0 && Clock::now() >= deadline) break;
+    }
+    return applied;
+  }
+}
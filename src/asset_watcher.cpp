@@ -0,0 +1,158 @@
+#include "starlet-engine/asset_watcher.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Starlet::Engine {
+  namespace fs = std::filesystem;
+
+  bool AssetWatcher::start(const std::string& rootIn, const std::chrono::milliseconds debounceIn) {
+    stop();
+
+    std::error_code ec;
+    if (!fs::is_directory(rootIn, ec)) return Logger::error("AssetWatcher", "start", "Not a directory: " + rootIn);
+
+#ifdef __linux__
+    descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (descriptor < 0) return Logger::error("AssetWatcher", "start", "inotify_init1 failed");
+#endif
+
+    root = fs::path(rootIn).lexically_normal().string();
+    debounce = debounceIn;
+    stopping = false;
+    running = true;
+    thread = std::thread(&AssetWatcher::watchLoop, this);
+    return Logger::debug("AssetWatcher", "start", "Watching " + root);
+  }
+
+  void AssetWatcher::stop() {
+    if (!thread.joinable()) return;
+
+    stopping = true;
+    thread.join();
+    running = false;
+    pending.clear();
+  }
+
+  void AssetWatcher::takeChanges(std::vector<std::string>& out) {
+    std::lock_guard<std::mutex> lock(readyMutex);
+    out.insert(out.end(), ready.begin(), ready.end());
+    ready.clear();
+  }
+
+  bool AssetWatcher::isExcluded(const std::string& relativePath) const {
+    for (const std::string& directory : excluded) {
+      if (relativePath.compare(0, directory.size(), directory) != 0) continue;
+      if (relativePath.size() == directory.size() || relativePath[directory.size()] == '/') return true;
+    }
+    return false;
+  }
+
+  void AssetWatcher::markChanged(const std::string& relativePath) {
+    if (isExcluded(relativePath)) return;
+    pending[relativePath] = std::chrono::steady_clock::now();
+  }
+
+  void AssetWatcher::flushSettled() {
+    const TimePoint now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(readyMutex);
+    for (auto it = pending.begin(); it != pending.end();) {
+      if (now - it->second < debounce) {
+        ++it;
+        continue;
+      }
+      ready.push_back(it->first);
+      it = pending.erase(it);
+    }
+  }
+
+#ifdef __linux__
+  void AssetWatcher::watchLoop() {
+    // start() created the descriptor; the loop owns it from here.
+    const int fd = descriptor;
+
+    constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+    std::unordered_map<int, std::string> directories;
+    const auto watchTree = [&](const fs::path& directory) {
+      std::error_code ec;
+      const std::string relative = fs::relative(directory, root, ec).generic_string();
+      if (isExcluded(relative)) return;
+      const int wd = inotify_add_watch(fd, directory.c_str(), mask);
+      if (wd >= 0) directories[wd] = relative;
+      for (fs::recursive_directory_iterator it(directory, ec), end; it != end; it.increment(ec)) {
+        if (!it->is_directory(ec)) continue;
+        if (isExcluded(fs::relative(it->path(), root, ec).generic_string())) {
+          it.disable_recursion_pending();
+          continue;
+        }
+        const int childWd = inotify_add_watch(fd, it->path().c_str(), mask);
+        if (childWd >= 0) directories[childWd] = fs::relative(it->path(), root, ec).generic_string();
+      }
+    };
+    watchTree(root);
+
+    alignas(inotify_event) char buffer[4096];
+    while (!stopping) {
+      pollfd descriptor{ fd, POLLIN, 0 };
+      if (poll(&descriptor, 1, 50) > 0) {
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+          for (char* cursor = buffer; cursor < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            const auto directory = directories.find(event->wd);
+            if (directory == directories.end() || event->len == 0) continue;
+
+            const std::string relative = directory->second == "." ? event->name : directory->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+              if (event->mask & (IN_CREATE | IN_MOVED_TO)) watchTree(fs::path(root) / relative);
+              continue;
+            }
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) markChanged(relative);
+          }
+        }
+      }
+      flushSettled();
+    }
+
+    close(fd);
+    descriptor = -1;
+    running = false;
+  }
+#else
+  void AssetWatcher::watchLoop() {
+    // Portable fallback: compare modification times every poll interval.
+    std::unordered_map<std::string, fs::file_time_type> stamps;
+    const auto scan = [&](const bool report) {
+      std::error_code ec;
+      for (fs::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
+        const std::string relative = fs::relative(it->path(), root, ec).generic_string();
+        if (it->is_directory(ec) && isExcluded(relative)) it.disable_recursion_pending();
+        if (!it->is_regular_file(ec)) continue;
+
+        const fs::file_time_type stamp = it->last_write_time(ec);
+        const auto known = stamps.find(relative);
+        if (known == stamps.end() || known->second != stamp) {
+          stamps[relative] = stamp;
+          if (report) markChanged(relative);
+        }
+      }
+    };
+    scan(false);
+
+    while (!stopping) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+      scan(true);
+      flushSettled();
+    }
+    running = false;
+  }
+#endif
+}
@@ -27,4 +27,24 @@ void mouse_button_callback(GLFWwindow* window, const int button, const int actio
 	Starlet::Engine::Engine* engine = static_cast<Starlet::Engine::Engine*>(glfwGetWindowUserPointer(window));
 	if (!engine) return;
 	engine->onButton({ button, action, mods });
+}
+void cursor_position_callback(GLFWwindow* window, const double, const double) {
+	Starlet::Engine::Engine* engine = static_cast<Starlet::Engine::Engine*>(glfwGetWindowUserPointer(window));
+	if (!engine) return;
+	engine->onCursorMove();
+}
+void window_focus_callback(GLFWwindow* window, const int focused) {
+	Starlet::Engine::Engine* engine = static_cast<Starlet::Engine::Engine*>(glfwGetWindowUserPointer(window));
+	if (!engine) return;
+	engine->onWindowFocus(focused == GLFW_TRUE);
+}
+void window_iconify_callback(GLFWwindow* window, const int iconified) {
+	Starlet::Engine::Engine* engine = static_cast<Starlet::Engine::Engine*>(glfwGetWindowUserPointer(window));
+	if (!engine) return;
+	engine->onWindowIconify(iconified == GLFW_TRUE);
+}
+void window_refresh_callback(GLFWwindow* window) {
+	Starlet::Engine::Engine* engine = static_cast<Starlet::Engine::Engine*>(glfwGetWindowUserPointer(window));
+	if (!engine) return;
+	engine->requestRedraw();
 }
\ No newline at end of file
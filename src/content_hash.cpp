@@ -0,0 +1,22 @@
+#include "starlet-engine/content_hash.hpp"
+
+#include "starlet-engine/mapped_file.hpp"
+
+#include <filesystem>
+
+namespace Starlet::Engine {
+  bool hashFile(const std::string& path, std::uint64_t& hash) {
+    MappedFile file;
+    if (file.open(path)) {
+      hash = hashBytes(file.data(), file.size());
+      return true;
+    }
+
+    // Empty files cannot be mapped but still have a well-defined hash.
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec) || std::filesystem::file_size(path, ec) != 0 || ec) return false;
+
+    hash = HASH_SEED;
+    return true;
+  }
+}
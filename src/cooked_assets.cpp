@@ -0,0 +1,262 @@
+#include "starlet-engine/cooked_assets.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include "starlet-engine/content_hash.hpp"
+#include "starlet-engine/vertex_layout.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+namespace Starlet::Engine {
+  namespace {
+    std::string replaceExtension(const std::string& sourcePath, const char* extension) {
+      const size_t dot = sourcePath.find_last_of('.');
+      const size_t slash = sourcePath.find_last_of("/\\");
+      const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+      return (hasExtension ? sourcePath.substr(0, dot) : sourcePath) + extension;
+    }
+
+    // Writes to a temporary file and renames so a reader never maps a partial file.
+    bool writeAtomically(const std::string& path, const std::vector<std::pair<const void*, size_t>>& chunks) {
+      const std::string tempPath = path + ".tmp";
+      FILE* file = std::fopen(tempPath.c_str(), "wb");
+      if (!file) return false;
+
+      bool written = true;
+      for (const auto& [data, size] : chunks)
+        written = written && (size == 0 || std::fwrite(data, size, 1, file) == 1);
+      std::fclose(file);
+
+      std::remove(path.c_str());
+      if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+      }
+      return true;
+    }
+
+    template<typename Header>
+    bool mapCooked(const std::string& sourcePath, const std::string& cookedPath, const std::uint32_t magic, const std::uint32_t version, MappedFile& file, Header& header) {
+      std::uint64_t sourceSize = 0;
+      std::int64_t sourceModified = 0;
+      if (!readSourceStamp(sourcePath, sourceSize, sourceModified) || !file.open(cookedPath)) return false;
+
+      if (file.size() >= sizeof(Header)) {
+        std::memcpy(&header, file.data(), sizeof(Header));
+        if (header.magic == magic && header.formatVersion == version && header.sourceSize == sourceSize) {
+          // Only a source touched since cooking (or copied elsewhere) is read and hashed.
+          if (header.sourceModified == sourceModified) return true;
+          std::uint64_t sourceHash = 0;
+          if (hashFile(sourcePath, sourceHash) && header.sourceHash == sourceHash) return true;
+        }
+      }
+      file.close();
+      return false;
+    }
+
+    template<typename Cooked>
+    CookStatus checkCooked(const std::string& sourcePath) {
+      std::uint64_t sourceSize = 0;
+      std::int64_t sourceModified = 0;
+      if (!readSourceStamp(sourcePath, sourceSize, sourceModified)) return CookStatus::NoSource;
+
+      Cooked cooked;
+      if (cooked.open(sourcePath)) return CookStatus::Valid;
+
+      MappedFile file;
+      return file.open(Cooked::cookedPathFor(sourcePath)) ? CookStatus::Stale : CookStatus::Missing;
+    }
+  }
+
+  bool readSourceStamp(const std::string& sourcePath, std::uint64_t& size, std::int64_t& modified) {
+    std::error_code error;
+    const std::uintmax_t bytes = std::filesystem::file_size(sourcePath, error);
+    if (error) return false;
+    const auto time = std::filesystem::last_write_time(sourcePath, error);
+    if (error) return false;
+
+    size = bytes;
+    modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+  }
+
+  std::string CookedMesh::cookedPathFor(const std::string& sourcePath) {
+    return replaceExtension(sourcePath, ".smesh");
+  }
+
+  std::uint32_t CookedMesh::strideFor(const std::uint32_t attributes) {
+    std::uint32_t stride = 0;
+    if (attributes & VERTEX_POSITION) stride += 3 * sizeof(float);
+    if (attributes & VERTEX_NORMAL)   stride += 3 * sizeof(float);
+    if (attributes & VERTEX_TEXCOORD) stride += 2 * sizeof(float);
+    if (attributes & VERTEX_COLOR)    stride += 4;
+    return stride;
+  }
+
+  CookStatus CookedMesh::check(const std::string& sourcePath) {
+    return checkCooked<CookedMesh>(sourcePath);
+  }
+
+  bool CookedMesh::open(const std::string& sourcePath) {
+    if (!mapCooked(sourcePath, cookedPathFor(sourcePath), MAGIC, FORMAT_VERSION, file, header)) return false;
+
+    const size_t expected = sizeof(CookedMeshHeader) + size_t{ header.vertexCount } * header.vertexStride + size_t{ header.indexCount } * header.indexSize;
+    if (header.vertexStride != strideFor(header.attributes) || (header.indexSize != 2 && header.indexSize != 4) || file.size() != expected) {
+      file.close();
+      return Logger::error("CookedMesh", "open", "Malformed cooked mesh: " + cookedPathFor(sourcePath));
+    }
+    return true;
+  }
+
+  bool CookedMesh::upload(CookedMeshBuffers& out) const {
+    if (!file.isOpen()) return Logger::error("CookedMesh", "upload", "No cooked mesh open");
+
+    out.indexCount = header.indexCount;
+    out.indexType = header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    glGenVertexArrays(1, &out.vertexArray);
+    glGenBuffers(1, &out.vertexBuffer);
+    glGenBuffers(1, &out.indexBuffer);
+    glBindVertexArray(out.vertexArray);
+
+    glBindBuffer(GL_ARRAY_BUFFER, out.vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size_t{ header.vertexCount } * header.vertexStride), getVertices(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, out.indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(size_t{ header.indexCount } * header.indexSize), getIndices(), GL_STATIC_DRAW);
+
+    const GLsizei stride = static_cast<GLsizei>(header.vertexStride);
+    size_t offset = 0;
+    const auto attribute = [&](const std::uint32_t flag, const GLuint location, const GLint components, const GLenum type, const GLboolean normalized, const size_t bytes) {
+      if (!(header.attributes & flag)) return;
+      glEnableVertexAttribArray(location);
+      glVertexAttribPointer(location, components, type, normalized, stride, reinterpret_cast<const void*>(offset));
+      offset += bytes;
+    };
+    attribute(VERTEX_POSITION, POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+    attribute(VERTEX_NORMAL,   NORMAL_LOCATION,   3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+    attribute(VERTEX_TEXCOORD, TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float));
+    attribute(VERTEX_COLOR,    COLOR_LOCATION,    4, GL_UNSIGNED_BYTE, GL_TRUE, 4);
+
+    glBindVertexArray(0);
+    return true;
+  }
+
+  bool CookedMesh::write(const std::string& path, const CookedMeshHeader& header, const std::vector<unsigned char>& vertices, const std::vector<unsigned char>& indices) {
+    if (!writeAtomically(path, { { &header, sizeof(header) }, { vertices.data(), vertices.size() }, { indices.data(), indices.size() } }))
+      return Logger::error("CookedMesh", "write", "Failed to write cooked mesh: " + path);
+    return true;
+  }
+
+  std::string CookedTexture::cookedPathFor(const std::string& sourcePath) {
+    return replaceExtension(sourcePath, ".stex");
+  }
+
+  CookStatus CookedTexture::check(const std::string& sourcePath) {
+    return checkCooked<CookedTexture>(sourcePath);
+  }
+
+  std::uint64_t CookedTexture::mipSizeFor(const CookedTextureFormat format, const std::uint32_t width, const std::uint32_t height) {
+    if (format == CookedTextureFormat::BC1) return std::uint64_t{ (width + 3) / 4 } * ((height + 3) / 4) * 8;
+    return std::uint64_t{ width } * height * 4;
+  }
+
+  bool CookedTexture::open(const std::string& sourcePath) {
+    if (!mapCooked(sourcePath, cookedPathFor(sourcePath), MAGIC, FORMAT_VERSION, file, header)) return false;
+
+    const size_t tableEnd = sizeof(CookedTextureHeader) + size_t{ header.mipCount } * sizeof(CookedMipLevel);
+    bool valid = header.mipCount > 0 && header.mipCount <= MAX_MIP_COUNT && header.width > 0 && header.height > 0
+      && header.format <= static_cast<std::uint32_t>(CookedTextureFormat::BC1) && file.size() >= tableEnd;
+
+    // Every level must be the next halving of the base and lie wholly inside
+    // the file, so upload() never hands the driver a short read.
+    const std::uint64_t pixelBytes = valid ? file.size() - tableEnd : 0;
+    const CookedTextureFormat format = static_cast<CookedTextureFormat>(header.format);
+    for (std::uint32_t level = 0; valid && level < header.mipCount; ++level) {
+      const CookedMipLevel& mip = getMip(level);
+      valid = mip.width == std::max(1u, header.width >> level) && mip.height == std::max(1u, header.height >> level)
+        && mip.size == mipSizeFor(format, mip.width, mip.height)
+        && mip.offset <= pixelBytes && mip.size <= pixelBytes - mip.offset;
+    }
+
+    if (!valid) {
+      file.close();
+      return Logger::error("CookedTexture", "open", "Malformed cooked texture: " + cookedPathFor(sourcePath));
+    }
+    return true;
+  }
+
+  bool CookedTexture::upload(unsigned int& texture) const {
+    if (!file.isOpen()) return Logger::error("CookedTexture", "upload", "No cooked texture open");
+
+    const bool compressed = header.format == static_cast<std::uint32_t>(CookedTextureFormat::BC1);
+    if (compressed && !glfwExtensionSupported("GL_EXT_texture_compression_s3tc")) {
+      Logger::debug("CookedTexture", "upload", "S3TC unsupported by driver, using source texture");
+      return false;
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (std::uint32_t level = 0; level < header.mipCount; ++level) {
+      const CookedMipLevel& mip = getMip(level);
+      const GLsizei width = static_cast<GLsizei>(mip.width), height = static_cast<GLsizei>(mip.height);
+      if (compressed) glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_COMPRESSED_RGB_S3TC_DXT1_EXT, width, height, 0, static_cast<GLsizei>(mip.size), getMipData(level));
+      else glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, getMipData(level));
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(header.mipCount - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header.mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+  }
+
+  bool CookedTexture::write(const std::string& path, const CookedTextureHeader& header, const std::vector<CookedMipLevel>& mips, const std::vector<unsigned char>& pixels) {
+    if (!writeAtomically(path, { { &header, sizeof(header) }, { mips.data(), mips.size() * sizeof(CookedMipLevel) }, { pixels.data(), pixels.size() } }))
+      return Logger::error("CookedTexture", "write", "Failed to write cooked texture: " + path);
+    return true;
+  }
+
+  AssetLoader::Decode decodeCookedMesh(const std::string& sourcePath, std::function<bool(const CookedMeshBuffers&)> onLoaded, AssetLoader::Decode fallback) {
+    return [sourcePath, onLoaded = std::move(onLoaded), fallback = std::move(fallback)]() -> AssetLoader::Upload {
+      auto mesh = std::make_shared<CookedMesh>();
+      if (!mesh->open(sourcePath)) return fallback ? fallback() : AssetLoader::Upload();
+
+      return [mesh, onLoaded] {
+        CookedMeshBuffers buffers;
+        return mesh->upload(buffers) && onLoaded(buffers);
+      };
+    };
+  }
+
+  AssetLoader::Decode decodeCookedTexture(const std::string& sourcePath, std::function<bool(unsigned int)> onLoaded, AssetLoader::Decode fallback) {
+    return [sourcePath, onLoaded = std::move(onLoaded), fallback = std::move(fallback)]() -> AssetLoader::Upload {
+      auto texture = std::make_shared<CookedTexture>();
+      if (!texture->open(sourcePath)) return fallback ? fallback() : AssetLoader::Upload();
+
+      // Only compressed textures can be refused by the driver; for those the
+      // source is decoded here too, since its upload must be ready by then.
+      const bool compressed = texture->getHeader().format != static_cast<std::uint32_t>(CookedTextureFormat::RGBA8);
+      AssetLoader::Upload fallbackUpload = compressed && fallback ? fallback() : AssetLoader::Upload();
+      return [texture, onLoaded, fallbackUpload] {
+        unsigned int id = 0;
+        if (texture->upload(id)) return onLoaded(id);
+        return fallbackUpload ? fallbackUpload() : false;
+      };
+    };
+  }
+}
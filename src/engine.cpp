@@ -1,6 +1,11 @@
 #include "starlet-engine/engine.hpp"
 #include "starlet-logger/logger.hpp"
 
+#include "starlet-engine/content_hash.hpp"
+#include "starlet-engine/profiler.hpp"
+#include "starlet-engine/scene_assets.hpp"
+
+#include "starlet-scene/component/grid.hpp"
 #include "starlet-scene/component/model.hpp"
 #include "starlet-scene/component/texture_data.hpp"
 
@@ -9,135 +14,1033 @@
 #include "starlet-scene/system/camera_fov_system.hpp"
 #include "starlet-scene/system/velocity_system.hpp"
 
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
 namespace Starlet::Engine {
-  Engine::Engine() : renderer(resourceManager) {}
+  static constexpr size_t FRAME_ARENA_SIZE{ size_t{ 1 } << 20 };
+  static constexpr float MAX_VARIABLE_DELTA{ 0.1f };
+  // Background uploads applied per frame, and how finely a preload's
+  // ResourceManager loads are split to fit in it.
+  static constexpr double UPLOAD_BUDGET_MS{ 4.0 };
+  static constexpr size_t MESHES_PER_STEP{ 8 };
+  static constexpr size_t TEXTURES_PER_STEP{ 2 };
+
+  static constexpr const char* PROGRAM_NAME{ "shader1" };
+  static constexpr const char* VERTEX_SHADER{ "vertex_shader.glsl" };
+  static constexpr const char* FRAGMENT_SHADER{ "fragment_shader.glsl" };
+  static constexpr const char* INSTANCED_PROGRAM_NAME{ "instanced" };
+  // Asset subdirectories never referenced by scene files.
+  static const std::vector<std::string> SCENE_PREFETCH_EXCLUDED{ "scenes", "shaders" };
+
+  // The job system and the loader pool split the cores instead of each taking
+  // all but one: loaders mostly block on I/O, so they get a quarter (at least
+  // one) and the job workers get what is left after the main thread.
+  static unsigned int loaderThreadCount() {
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1u, hardware / 4);
+  }
+
+  static unsigned int jobWorkerCount() {
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int reserved = 1 + loaderThreadCount();
+    return hardware > reserved ? hardware - reserved : 1;
+  }
+
+  Engine::Engine()
+    : jobSystem(jobWorkerCount()), frameArenas(jobSystem.getThreadCount(), FRAME_ARENA_SIZE),
+      assetLoader(loaderThreadCount()) {
+    frameContext.jobs = &jobSystem;
+    frameContext.arenas = &frameArenas;
+    frameContext.demand = &frameDemand;
+    // Programs are built from full paths: scene shaders under the asset root,
+    // generated ones under the cache directory.
+    shaderManager.setBasePath("");
+  }
 
   void Engine::setAssetPaths(const std::string& path) {
-    shaderManager.setBasePath((path + "/shaders/").c_str());
-    resourceManager.setBasePath(path);
-    sceneManager.setBasePath((path + "/scenes/").c_str());
+    assetPath = path;
+    setScenePath(path + "/scenes");
+
+    std::error_code ec;
+    std::filesystem::path root = std::filesystem::absolute(path, ec).lexically_normal();
+    if (!root.has_filename()) root = root.parent_path();
+    setCachePath(root.string() + ".cache");
+  }
+
+  void Engine::setCachePath(const std::string& path) {
+    cachePath = path;
+    programCache.setDirectory(path + "/shaders");
+  }
+
+  void Engine::setScenePath(const std::string& path) {
+    scenePath = path + "/";
+    for (Scene::SceneManager& slot : sceneSlots) slot.setBasePath(scenePath.c_str());
+  }
+
+  void Engine::setFixedTimestep(const double tickRate, const unsigned int maxStepsPerFrame) {
+    fixedTimestep.setTickRate(tickRate);
+    fixedTimestep.setMaxSteps(maxStepsPerFrame);
+    fixedStepEnabled = true;
+  }
+
+  void Engine::setPresentMode(const PresentMode mode, const double targetFps) {
+    framePacer.setMode(mode, targetFps);
+
+    const int interval = framePacer.getSwapInterval();
+    runOnContextThread([this, interval] { windowManager.setSwapInterval(interval); });
   }
 
   bool Engine::initialize(const unsigned int width, const unsigned int height, const char* title) {
-    Logger::debug("Engine", "initialize", "Start time: " + std::to_string(glfwGetTime()));
+    STARLET_PROFILE_ZONE("Engine::initialize");
+    const Clock::Ticks start = Clock::now();
 
     if (!windowManager.createWindow(width, height, title))
       return Logger::error("Engine", "initialize", "Failed to initialize window");
 
-    if (!shaderManager.createProgramFromPaths("shader1", "vertex_shader.glsl", "fragment_shader.glsl"))
+    windowManager.setWindowPointer(this);
+    framePacer.setRefreshRate(windowManager.getRefreshRate());
+    if (!hasGraphics())
+      return Logger::debug("Engine", "initialize", "Initialized without graphics in " + std::to_string(Clock::toMilliseconds(Clock::now() - start)) + "ms");
+
+    programCache.setDriverId(windowManager.getDriverId());
+
+    bool fromCache = false;
+    const Clock::Ticks programStart = Clock::now();
+    const unsigned int program = buildProgram(PROGRAM_NAME, assetPath + "/shaders/" + VERTEX_SHADER, assetPath + "/shaders/" + FRAGMENT_SHADER, fromCache);
+    if (program == 0)
       return Logger::error("Engine", "initialize", "Failed to create shader program from file");
+    programCache.registerProgram(PROGRAM_NAME, program);
+    Logger::debug("Engine", "initialize", std::string(PROGRAM_NAME) + (fromCache ? " loaded from binary cache (warm) in " : " compiled from source (cold) in ")
+      + std::to_string(Clock::toMilliseconds(Clock::now() - programStart)) + "ms");
 
-    if (!glState.setProgram(shaderManager.getProgramID("shader1")))
+    if (!glState.setProgram(program))
       return Logger::error("GLStateManager", "init", "Failed to set initial program");
 
-    if (!renderer.init(glState.getProgram()))
-      return Logger::error("Engine", "initialize", "Failed to setup shaders for renderer");
+    // Without a model uniform to replace the scene still draws; only batches are skipped.
+    buildInstancedProgram();
 
     glState.setGLStateDefault();
-    windowManager.setWindowPointer(this);
-    return Logger::debug("Engine", "initialize", "Finish Time: " + std::to_string(glfwGetTime()));
+    return Logger::debug("Engine", "initialize", "Initialized in " + std::to_string(Clock::toMilliseconds(Clock::now() - start)) + "ms");
+  }
+
+  bool Engine::setHotReload(const bool enabled) {
+    if (!enabled) {
+      assetWatcher.stop();
+      return true;
+    }
+    if (assetPath.empty()) return Logger::error("Engine", "setHotReload", "Asset paths must be set before enabling hot reload");
+
+    // A cache placed inside the asset tree must not report the engine's own writes as edits.
+    std::vector<std::string> excluded;
+    std::error_code ec;
+    const std::filesystem::path root = std::filesystem::absolute(assetPath, ec).lexically_normal();
+    const std::filesystem::path cache = std::filesystem::absolute(cachePath, ec).lexically_normal();
+    const std::string relative = cache.lexically_relative(root).generic_string();
+    if (!cachePath.empty() && !relative.empty() && relative.compare(0, 2, "..") != 0) excluded.push_back(relative);
+    assetWatcher.setExcluded(std::move(excluded));
+
+    return assetWatcher.start(assetPath);
   }
 
   bool Engine::loadScene(const std::string& sceneIn) {
-    Logger::debug("Engine", "loadScene", "Start time: " + std::to_string(glfwGetTime()));
+    STARLET_PROFILE_ZONE("Engine::loadScene");
+    loadStats.clear();
+    const std::string sceneName = sceneIn.empty() ? "EmptyScene" : sceneIn;
 
-    if (sceneIn.empty()) {
-      if (!sceneManager.loadTxtScene("EmptyScene.txt"))
-        return Logger::error("Engine", "loadScene", "No scene loaded and failed to load Default \"EmptyScene\"");
+    if (!parseScene(*sceneManager, sceneName, loadStats))
+      return Logger::error("Engine", "loadScene", sceneIn.empty()
+        ? "No scene loaded and failed to load Default \"EmptyScene\""
+        : "Failed to load scene: " + sceneIn);
+
+    ResourceList keep;
+    if (scenePreloader) {
+      ScopedLoadStage stage(loadStats, "preloadResources");
+      AssetLoader::Upload upload = scenePreloader(*sceneManager, resourceRegistry, keep);
+      if (upload && hasGraphics() && !upload())
+        return Logger::error("Engine", "loadScene", "Failed to upload preloaded resources for scene: " + sceneName);
+    }
+
+    std::vector<std::string> assetFiles;
+    if (hasGraphics()) {
+      // ResourceManager reads and decodes synchronously, so the loader pool pulls
+      // the scene's files into the OS cache ahead of it; the mesh and texture
+      // loads then overlap with the remaining reads instead of waiting on disk.
+      const AssetLoader::Batch batch = assetLoader.createBatch();
+      {
+        ScopedLoadStage stage(loadStats, "queuePrefetch");
+        for (std::string& file : findSceneAssetFiles(*sceneManager, assetFiles))
+          assetLoader.run([file = std::move(file)] { return prefetchFile(file); }, batch);
+      }
+      bool loaded = true;
+      for (AssetLoader::Upload& step : sceneResourceSteps(*sceneManager, sceneName, loadStats, keep))
+        if (!step()) {
+          loaded = false;
+          break;
+        }
+      {
+        // Only this scene's prefetches are waited on; they never queue uploads,
+        // so the loader threads cannot stall on a queue nothing is draining.
+        ScopedLoadStage stage(loadStats, "prefetchWait");
+        if (!assetLoader.wait(batch))
+          Logger::error("Engine", "loadScene", "Failed to prefetch some assets for scene: " + sceneName);
+      }
+      if (!loaded) return false;
+    }
+    activeSceneName = sceneName;
+    sceneAssets.swap(assetFiles);
+
+    if (hasGraphics()) {
+      ScopedLoadStage stage(loadStats, "batchGrids");
+      batchSceneGrids(*sceneManager, keep);
     }
-    else if (!sceneManager.loadTxtScene(sceneIn + ".txt"))
-      return Logger::error("Engine", "loadScene", "Failed to load scene: " + sceneIn);
+    sceneResources.swap(keep);
+    keep.clear();
+    if (hasGraphics()) resourceRegistry.collect();
 
-    Logger::debug("ResourceLoader", "loadMeshes", "Start time: " + std::to_string(glfwGetTime()));
-    if (!resourceManager.loadMeshes(sceneManager.getScene().getComponentsOfType<Scene::Model>()))
-      return Logger::error("Engine", "loadMeshes", "Failed to load meshes for scene: " + sceneIn);
-    Logger::debug("ResourceLoader", "loadMeshes", "Finish time: " + std::to_string(glfwGetTime()));
+    registerDefaultSystems(*sceneManager);
+    requestRedraw();
+    return Logger::debug("Engine", "loadScene", sceneName + ": " + loadStats.toString());
+  }
 
-    Logger::debug("ResourceLoader", "loadTextures", "Start time: " + std::to_string(glfwGetTime()));
-    if (!resourceManager.loadTextures(sceneManager.getScene().getComponentsOfType<Scene::TextureData>()))
-      return Logger::error("Engine", "loadTextures", "Failed to load textures for scene: " + sceneIn);
-    Logger::debug("ResourceLoader", "loadTextures", "Finish time: " + std::to_string(glfwGetTime()));
+  bool Engine::preloadScene(const std::string& sceneIn) {
+    if (preloading) return Logger::error("Engine", "preloadScene", "Already preloading scene: " + stagedSceneName);
 
-    Logger::debug("ResourceLoader", "processPrimitives", "Start time: " + std::to_string(glfwGetTime()));
-    if (!resourceManager.processPrimitives(sceneManager))
-      return Logger::error("Engine", "processPrimitives", "Failed to process primitives for scene: " + sceneIn);
-    Logger::debug("ResourceLoader", "processPrimitives", "Finish time: " + std::to_string(glfwGetTime()));
+    preloading = true;
+    stagedReady = false;
+    stagedSceneName = sceneIn.empty() ? "EmptyScene" : sceneIn;
+    stagedResources.clear();
+    stagedSceneAssets.clear();
+    stagedLoadStats.clear();
 
-    Logger::debug("ResourceLoader", "processGrids", "Start time: " + std::to_string(glfwGetTime()));
-    if (!resourceManager.processGrids(sceneManager))
-      return Logger::error("Engine", "processGrids", "Failed to process grids for scene: " + sceneIn);
-    Logger::debug("ResourceLoader", "processGrids", "Finish time: " + std::to_string(glfwGetTime()));
+    // Parsing, decoding and prefetching run on the loader pool. The upload and
+    // the ResourceManager loads follow as small steps the per-frame pump
+    // applies within its budget, so activation is left with only the swap and
+    // the eviction.
+    stagedFailed = false;
+    assetLoader.enqueueSteps([this]() -> std::vector<AssetLoader::Upload> {
+      if (!parseScene(*stagedSceneManager, stagedSceneName, stagedLoadStats)) {
+        preloading = false;
+        return {};
+      }
 
-    Logger::debug("ResourceLoader", "processTextureConnection", "Start time: " + std::to_string(glfwGetTime()));
-    if (!resourceManager.processTextureConnections(sceneManager.getScene()))
-      return Logger::error("Engine", "processTextureConnection", "Failed to connect texture handles for scene: " + sceneIn);
-    Logger::debug("ResourceLoader", "processTextureConnection", "Finish time: " + std::to_string(glfwGetTime()));
+      AssetLoader::Upload upload;
+      if (scenePreloader) upload = scenePreloader(*stagedSceneManager, resourceRegistry, stagedResources);
+      {
+        ScopedLoadStage stage(stagedLoadStats, "prefetch");
+        for (const std::string& file : findSceneAssetFiles(*stagedSceneManager, stagedSceneAssets)) prefetchFile(file);
+      }
 
-    sceneManager.getScene().registerSystem(std::make_unique<Scene::CameraMoveSystem>());
-    sceneManager.getScene().registerSystem(std::make_unique<Scene::CameraLookSystem>());
-    sceneManager.getScene().registerSystem(std::make_unique<Scene::CameraFovSystem>());
-    sceneManager.getScene().registerSystem(std::make_unique<Scene::VelocitySystem>());
+      std::vector<AssetLoader::Upload> loads;
+      if (hasGraphics()) {
+        if (upload) loads.push_back(std::move(upload));
+        for (AssetLoader::Upload& step : sceneResourceSteps(*stagedSceneManager, stagedSceneName, stagedLoadStats, stagedResources))
+          loads.push_back(std::move(step));
+      }
 
-    return Logger::debug("Engine", "loadScene", "Finish Time: " + std::to_string(glfwGetTime()));
+      std::vector<AssetLoader::Upload> steps;
+      for (AssetLoader::Upload& load : loads)
+        steps.push_back([this, load = std::move(load)] {
+          if (stagedFailed) return true;
+          stagedFailed = !load();
+          return !stagedFailed;
+        });
+      // Last, so a new preload cannot start while earlier steps are queued.
+      steps.push_back([this] {
+        if (!stagedFailed) {
+          stagedReady = true;
+          return true;
+        }
+        stagedResources.clear();
+        resourceRegistry.collect();
+        preloading = false;
+        return Logger::error("Engine", "preloadScene", "Failed to load resources for scene: " + stagedSceneName);
+      });
+      return steps;
+    });
+    return Logger::debug("Engine", "preloadScene", "Preloading " + stagedSceneName);
   }
 
-  void Engine::run() {
-    windowManager.switchActiveWindowVisibility();
+  bool Engine::activatePreloadedScene() {
+    if (!stagedReady) return Logger::error("Engine", "activatePreloadedScene", preloading
+      ? "Scene still preloading: " + stagedSceneName
+      : "No scene preloaded");
 
-    while (!windowManager.shouldClose()) {
-      const float deltaTime = timer.tick();
+    // Runs between frames while the simulation waits, so neither thread sees a half-swapped scene.
+    return callOnContextThread([this] {
+      std::swap(sceneManager, stagedSceneManager);
+      sceneResources.swap(stagedResources);
+      loadStats = stagedLoadStats;
+      activeSceneName = stagedSceneName;
+      sceneAssets.swap(stagedSceneAssets);
+      stagedSceneAssets.clear();
+      if (hasGraphics()) batchSceneGrids(*sceneManager, sceneResources);
 
-      inputManager.reset();
-      windowManager.pollEvents();
-      inputManager.updateMousePosition(windowManager.getGLFWwindow());
+      // The outgoing scene's handles go last, so anything both scenes share is never evicted.
+      stagedResources.clear();
+      const size_t evicted = hasGraphics() ? resourceRegistry.collect() : 0;
+      stagedReady = false;
+      preloading = false;
 
-      handleKeyEvents(inputManager.consumeKeyEvents());
-      handleButtonEvents(inputManager.consumeButtonEvents());
+      registerDefaultSystems(*sceneManager);
+      requestRedraw();
+      return Logger::debug("Engine", "activatePreloadedScene", activeSceneName + ": " + loadStats.toString() + ", evicted " + std::to_string(evicted) + " resource(s)");
+    });
+  }
 
-      sceneManager.getScene().updateSystems(inputManager, deltaTime);
-      renderer.renderFrame(glState.getProgram(), sceneManager.getScene(), windowManager.getAspect());
+  bool Engine::parseScene(Scene::SceneManager& target, const std::string& sceneName, LoadStats& stats) {
+    ScopedLoadStage stage(stats, "parseScene");
+    return target.loadTxtScene(sceneName + ".txt");
+  }
 
-      windowManager.swapBuffers();
+  void Engine::registerDefaultSystems(Scene::SceneManager& target) {
+    // Systems belong to the scene instance, so each newly built scene needs its own set.
+    auto& scene = target.getScene();
+    scene.registerSystem(std::make_unique<Scene::CameraMoveSystem>());
+    scene.registerSystem(std::make_unique<Scene::CameraLookSystem>());
+    scene.registerSystem(std::make_unique<Scene::CameraFovSystem>());
+    scene.registerSystem(std::make_unique<Scene::VelocitySystem>());
+  }
+
+  std::vector<std::string> Engine::findSceneAssetFiles(Scene::SceneManager& target, std::vector<std::string>& relativeFiles) {
+    auto& scene = target.getScene();
+    std::vector<std::string> names;
+    for (const Scene::Model* model : scene.getComponentsOfType<Scene::Model>()) names.push_back(model->meshPath);
+    for (const Scene::TextureData* texture : scene.getComponentsOfType<Scene::TextureData>())
+      for (const std::string& path : texture->filePaths)
+        if (!path.empty()) names.push_back(path);
+
+    std::vector<std::string> files;
+    {
+      std::lock_guard<std::mutex> lock(assetIndexMutex);
+      if (assetIndex.empty()) assetIndex.build(assetPath, SCENE_PREFETCH_EXCLUDED);
+      files = assetIndex.resolve(names);
     }
+
+    const std::filesystem::path root(assetPath);
+    for (const std::string& file : files)
+      relativeFiles.push_back(std::filesystem::path(file).lexically_relative(root).generic_string());
+    return files;
   }
 
-  void Engine::handleKeyEvents(const std::vector<KeyEvent>& keyEvents) {
-    for (const KeyEvent& event : keyEvents) {
-      if (event.action != GLFW_PRESS) continue;
+  Engine::SceneGraphics* Engine::createSceneGraphics(Scene::SceneManager& target, ResourceList& keep) {
+    auto graphics = std::make_shared<SceneGraphics>();
+    graphics->resources.setBasePath(assetPath);
+    if (!graphics->renderer.init(glState.getProgram())) {
+      Logger::error("Engine", "createSceneGraphics", "Failed to setup shaders for renderer");
+      return nullptr;
+    }
 
-      switch (event.key) {
-      case GLFW_KEY_ESCAPE: windowManager.requestClose(); break;
+    // Every load gets its own entry, so a scene never shares another's copy.
+    const size_t slot = slotOf(target);
+    sceneGraphics[slot] = graphics.get();
+    const ResourceKey key = hashString("starlet-engine:scene-graphics:" + std::to_string(++sceneGraphicsLoads));
+    keep.push_back(resourceRegistry.insert(key, [this, slot, graphics]() mutable {
+      if (sceneGraphics[slot] == graphics.get()) sceneGraphics[slot] = nullptr;
+      graphics.reset();
+    }));
+    return sceneGraphics[slot];
+  }
 
-#ifndef NDEBUG
-      case GLFW_KEY_P: toggleWireframe();  break;
-      case GLFW_KEY_C: toggleCursorLock(); break;
+  std::vector<AssetLoader::Upload> Engine::sceneResourceSteps(Scene::SceneManager& target, const std::string& sceneName, LoadStats& stats, ResourceList& keep) {
+    std::vector<AssetLoader::Upload> steps;
+    const size_t slot = slotOf(target);
+    steps.push_back([this, &target, &keep] { return createSceneGraphics(target, keep) != nullptr; });
+
+    auto& scene = target.getScene();
+    const std::vector<Scene::Model*> models = scene.getComponentsOfType<Scene::Model>();
+    for (size_t begin = 0; begin < models.size(); begin += MESHES_PER_STEP) {
+      std::vector<Scene::Model*> chunk(models.begin() + begin, models.begin() + std::min(models.size(), begin + MESHES_PER_STEP));
+      steps.push_back([this, slot, &stats, sceneName, chunk = std::move(chunk)] {
+        ScopedLoadStage stage(stats, "loadMeshes");
+        if (!sceneGraphics[slot]->resources.loadMeshes(chunk))
+          return Logger::error("Engine", "loadMeshes", "Failed to load meshes for scene: " + sceneName);
+        return true;
+      });
+    }
+
+    const std::vector<Scene::TextureData*> textures = scene.getComponentsOfType<Scene::TextureData>();
+    for (size_t begin = 0; begin < textures.size(); begin += TEXTURES_PER_STEP) {
+      std::vector<Scene::TextureData*> chunk(textures.begin() + begin, textures.begin() + std::min(textures.size(), begin + TEXTURES_PER_STEP));
+      steps.push_back([this, slot, &stats, sceneName, chunk = std::move(chunk)] {
+        ScopedLoadStage stage(stats, "loadTextures");
+        if (!sceneGraphics[slot]->resources.loadTextures(chunk))
+          return Logger::error("Engine", "loadTextures", "Failed to load textures for scene: " + sceneName);
+        return true;
+      });
+    }
+
+    steps.push_back([this, slot, &target, &stats, sceneName] {
+      ScopedLoadStage stage(stats, "processPrimitives");
+      if (!sceneGraphics[slot]->resources.processPrimitives(target))
+        return Logger::error("Engine", "processPrimitives", "Failed to process primitives for scene: " + sceneName);
+      return true;
+    });
+    // Instanced grids are expanded into the batcher when the scene activates.
+    if (!gridInstancing)
+      steps.push_back([this, slot, &target, &stats, sceneName] {
+        ScopedLoadStage stage(stats, "processGrids");
+        if (!sceneGraphics[slot]->resources.processGrids(target))
+          return Logger::error("Engine", "processGrids", "Failed to process grids for scene: " + sceneName);
+        return true;
+      });
+    steps.push_back([this, slot, &target, &stats, sceneName] {
+      ScopedLoadStage stage(stats, "processTextureConnections");
+      if (!sceneGraphics[slot]->resources.processTextureConnections(target.getScene()))
+        return Logger::error("Engine", "processTextureConnection", "Failed to connect texture handles for scene: " + sceneName);
+      return true;
+    });
+    return steps;
+  }
+
+  // Interleaved position, normal and texcoord at the shared VertexLocation slots.
+  static void uploadPrimitive(const std::vector<float>& vertices, const std::vector<unsigned short>& indices, unsigned int& vertexArray, unsigned int (&buffers)[2]) {
+    constexpr GLsizei STRIDE{ 8 * sizeof(float) };
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(2, buffers);
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(POSITION_LOCATION);
+    glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, STRIDE, nullptr);
+    glEnableVertexAttribArray(NORMAL_LOCATION);
+    glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, STRIDE, reinterpret_cast<const void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(TEXCOORD_LOCATION);
+    glVertexAttribPointer(TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, STRIDE, reinterpret_cast<const void*>(6 * sizeof(float)));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned short)), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+  }
+
+  ResourceHandle Engine::acquireGridMesh(const bool cube) {
+    const ResourceKey key = hashString(cube ? "starlet-engine:grid-cube" : "starlet-engine:grid-square");
+    if (ResourceHandle resident = resourceRegistry.acquire(key)) return resident;
+
+    // Faces as normal, then u and v edges with u x v = normal so each winds counter-clockwise.
+    static constexpr float FACES[6][9] = {
+      {  0,  1,  0,   1, 0,  0,   0, 0, -1 },
+      {  0, -1,  0,   1, 0,  0,   0, 0,  1 },
+      {  1,  0,  0,   0, 0, -1,   0, 1,  0 },
+      { -1,  0,  0,   0, 0,  1,   0, 1,  0 },
+      {  0,  0,  1,   1, 0,  0,   0, 1,  0 },
+      {  0,  0, -1,  -1, 0,  0,   0, 1,  0 },
+    };
+    static constexpr float CORNERS[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+
+    // A square is the cube's top face, lying in the XZ plane.
+    std::vector<float> vertices;
+    std::vector<unsigned short> indices;
+    for (unsigned short face = 0; face < (cube ? 6 : 1); ++face) {
+      const float* normal = FACES[face];
+      const float* u = FACES[face] + 3;
+      const float* v = FACES[face] + 6;
+      for (const auto& corner : CORNERS) {
+        for (int axis = 0; axis < 3; ++axis) vertices.push_back(0.5f * ((cube ? normal[axis] : 0.0f) + corner[0] * u[axis] + corner[1] * v[axis]));
+        vertices.insert(vertices.end(), normal, normal + 3);
+        vertices.push_back((corner[0] + 1.0f) * 0.5f);
+        vertices.push_back((corner[1] + 1.0f) * 0.5f);
+      }
+      const unsigned short base = static_cast<unsigned short>(face * 4);
+      for (const unsigned short index : { 0, 1, 2, 0, 2, 3 }) indices.push_back(static_cast<unsigned short>(base + index));
+    }
+
+    PrimitiveMesh& mesh = gridMeshes[cube ? 1 : 0];
+    uploadPrimitive(vertices, indices, mesh.vertexArray, mesh.buffers);
+    mesh.indexCount = static_cast<unsigned int>(indices.size());
+    return resourceRegistry.insert(key, [&mesh] {
+      glDeleteVertexArrays(1, &mesh.vertexArray);
+      glDeleteBuffers(2, mesh.buffers);
+      mesh = PrimitiveMesh{};
+    }, vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned short));
+  }
+
+  void Engine::batchSceneGrids(Scene::SceneManager& target, ResourceList& keep) {
+    instanceBatcher.clear();
+    if (!gridInstancing) return;
+
+    float transform[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+    for (const Scene::Grid* grid : target.getScene().getComponentsOfType<Scene::Grid>()) {
+      const bool cube = grid->type == Scene::GridType::Cube;
+      ResourceHandle mesh = acquireGridMesh(cube);
+      if (!mesh) continue;
+      keep.push_back(std::move(mesh));
+
+      // Every cell shares the mesh and the grid's colour, so each grid is one batch.
+      const PrimitiveMesh& primitive = gridMeshes[cube ? 1 : 0];
+      InstanceBatchKey key{ primitive.vertexArray, primitive.indexCount, 0, GL_UNSIGNED_SHORT };
+      key.colour = packColour(grid->colour[0], grid->colour[1], grid->colour[2], grid->colour[3]);
+
+      transform[0] = transform[5] = transform[10] = grid->size;
+      for (unsigned int x = 0; x < grid->countX; ++x)
+        for (unsigned int y = 0; y < grid->countY; ++y)
+          for (unsigned int z = 0; z < grid->countZ; ++z) {
+            transform[12] = grid->origin[0] + static_cast<float>(x) * grid->spacing;
+            transform[13] = grid->origin[1] + static_cast<float>(y) * grid->spacing;
+            transform[14] = grid->origin[2] + static_cast<float>(z) * grid->spacing;
+            instanceBatcher.add(key, transform);
+          }
+    }
+  }
+
+  void Engine::run(const unsigned int frameCount) {
+    if (!windowShown && windowManager.getBackend() == WindowBackend::Display) {
+      windowManager.switchActiveWindowVisibility();
+      windowShown = true;
+    }
+
+    // Index 0 of the job system and its frame arena belong to the thread running the loop.
+    jobSystem.setOwnerThread();
+
+    if (pipelinedRendering && hasGraphics())
+      renderThread.start(windowManager.getGLFWwindow(), [this] { renderFrame(); }, [this](const Clock::Ticks inputTimestamp) { presentFrame(inputTimestamp); });
+
+    for (unsigned int frame = 0; !windowManager.shouldClose() && (frameCount == 0 || frame < frameCount); ++frame) {
+      if (onDemandRendering && !waitForFrame()) break;
+
+      const Clock::Ticks frameStart = Clock::now();
+      float deltaTime = timer.tick();
+      frameDemand.beginFrame(frameStart);
+
+      // Nothing may hold arena memory across frames, so reset before any work.
+      frameArenas.reset();
+      frameContext.frameIndex = frameIndex;
+
+      if (assetWatcher.isRunning()) {
+        STARLET_PROFILE_ZONE("AssetReload");
+        applyAssetChanges();
+      }
+      // Hot reloads and scene preloads decode in the background; apply
+      // whatever finished since the last frame.
+      if (assetLoader.getPending() > 0) runOnContextThread([this] { assetLoader.pump(UPLOAD_BUDGET_MS); });
+
+      {
+        STARLET_PROFILE_ZONE("Input");
+        if (inputConsumed) inputManager.reset();
+        windowManager.pollEvents();
+
+        if (inputReplay.isOpen()) {
+          if (!replayInputFrame(deltaTime)) {
+            Logger::debug("Engine", "run", "Input replay finished after " + std::to_string(inputReplay.getFrameIndex()) + " frame(s)");
+            inputReplay.close();
+            break;
+          }
+        }
+        else {
+          GLFWwindow* window = windowManager.getGLFWwindow();
+          inputManager.updateMousePosition(window);
+
+          const InputEventSpan events = inputEvents.consume();
+          if (inputRecorder.isOpen()) {
+            double cursorX = 0.0, cursorY = 0.0;
+            if (window) glfwGetCursorPos(window, &cursorX, &cursorY);
+            inputRecorder.recordFrame(deltaTime, cursorX, cursorY, events);
+          }
+          handleInputEvents(events);
+        }
+
+        // Engine input handling reads the timestamped queue; the InputManager
+        // copies are only drained on frames that queued some, so frames
+        // without key or button input never touch the heap.
+        if (managerEventsQueued) {
+          inputManager.consumeKeyEvents();
+          inputManager.consumeButtonEvents();
+          managerEventsQueued = false;
+        }
+      }
+      double updateMs = 0.0;
+      {
+        STARLET_PROFILE_ZONE("Update");
+        const Clock::Ticks updateStart = Clock::now();
+        updateSimulation(deltaTime);
+        updateMs = Clock::toMilliseconds(Clock::now() - updateStart);
+        updateTimes.record(updateMs);
+      }
+
+      frameContext.interpolationAlpha = getInterpolationAlpha();
+      // Fixed-step input still waiting for a step needs the frames that run it.
+      if (!inputConsumed) frameDemand.markDirty();
+
+      // Input only reaches the screen on a frame that simulated it.
+      const Clock::Ticks shownInput = inputConsumed ? pendingInputTimestamp : 0;
+      if (inputConsumed) pendingInputTimestamp = 0;
+
+      if (renderThread.isRunning()) {
+        STARLET_PROFILE_ZONE("SubmitFrame");
+        renderThread.submitFrame(shownInput);
+      }
+      else if (hasGraphics()) {
+        renderFrame();
+        presentFrame(shownInput);
+      }
+
+      const double frameMs = Clock::toMilliseconds(Clock::now() - frameStart);
+      frameTimes.record(frameMs);
+      if (inputReplay.isOpen()) inputReplay.recordTiming(updateMs, frameMs);
+      framePacer.endFrame();
+      ++frameIndex;
+      STARLET_PROFILE_FRAME();
+    }
+
+    // Hand the context back so loadScene and friends work between runs.
+    renderThread.stop();
+
+#if STARLET_PROFILER_ENABLED
+    const FrameStats& stats = Profiler::get().getFrameStats();
+    Logger::debug("Engine", "run", "Frame time p50: " + std::to_string(stats.getP50()) + "ms, p99: " + std::to_string(stats.getP99()) + "ms");
+    if (inputLatency.getCount() > 0)
+      Logger::debug("Engine", "run", "Input-to-photon latency: " + inputLatency.toString());
+    Logger::debug("Engine", "run", "Frame intervals: " + framePacer.getFrameTimes().toString() + ", missed deadlines: " + std::to_string(framePacer.getMissedDeadlines()));
+    Logger::debug("Engine", "run", "Frame arena high-water: " + std::to_string(frameArenas.getHighWater()) + " bytes");
+    if (onDemandRendering) Logger::debug("Engine", "run", "Idle for " + std::to_string(getIdleSeconds()) + "s over " + std::to_string(frameIndex) + " frames");
 #endif
+  }
+
+  void Engine::applyAssetChanges() {
+    changedAssets.clear();
+    assetWatcher.takeChanges(changedAssets);
+    if (changedAssets.empty()) return;
+    frameDemand.markDirty();
+
+    // A file the index has never seen was just added; the next load rebuilds it.
+    {
+      std::lock_guard<std::mutex> lock(assetIndexMutex);
+      for (const std::string& path : changedAssets) {
+        if (assetIndex.contains(path)) continue;
+        assetIndex.clear();
+        break;
       }
     }
+
+    bool shaderChanged = false;
+    for (const std::string& path : changedAssets) {
+      if (path == std::string("shaders/") + VERTEX_SHADER || path == std::string("shaders/") + FRAGMENT_SHADER) {
+        shaderChanged = true;
+        continue;
+      }
+
+      bool handled = false;
+      for (const AssetReloadHandler& handler : reloadHandlers) {
+        AssetLoader::Decode decode = handler(path);
+        if (!decode) continue;
+
+        assetLoader.enqueue(std::move(decode));
+        handled = true;
+        break;
+      }
+      if (handled) continue;
+
+      // ResourceManager has no per-asset reload, and reloading the whole scene
+      // in place would reset its runtime state, so an unclaimed file waits for
+      // the next scene load.
+      if (std::find(sceneAssets.begin(), sceneAssets.end(), path) != sceneAssets.end())
+        Logger::debug("Engine", "applyAssetChanges", "No reload handler for " + path + ", used by " + activeSceneName + "; it takes effect on the next scene load");
+      else Logger::debug("Engine", "applyAssetChanges", "No reload handler for " + path);
+    }
+
+    // Shader sources are read, compiled and linked by ProgramCache, so the
+    // whole rebuild runs on the context thread. Other assets decode on the loader
+    // pool and their uploads are pumped at frame boundaries as they become ready.
+    if (shaderChanged) runOnContextThread([this] { reloadShaderProgram(); });
+  }
+
+  unsigned int Engine::buildProgram(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath, bool& fromCache) {
+    STARLET_PROFILE_ZONE("BuildProgram");
+    return programCache.build(name, { vertexPath, fragmentPath }, [&] {
+      // ShaderManager keeps every program it links under its name, so each
+      // build gets a fresh one; the ProgramCache registration owns the result.
+      const std::string buildName = name + "#" + std::to_string(++programBuilds);
+      if (!shaderManager.createProgramFromPaths(buildName, vertexPath, fragmentPath)) return 0u;
+      return shaderManager.getProgramID(buildName);
+    }, fromCache);
   }
 
-  void Engine::handleButtonEvents(const std::vector<Input::MouseButtonEvent>& buttonEvents) {
-    for (const Input::MouseButtonEvent& event : buttonEvents) {
-      std::string buttonName;
-      switch (event.button) {
-      case GLFW_MOUSE_BUTTON_LEFT:   buttonName = "Left"; break;
-      case GLFW_MOUSE_BUTTON_RIGHT:  buttonName = "Right"; break;
-      case GLFW_MOUSE_BUTTON_MIDDLE: buttonName = "Middle"; break;
-      case GLFW_MOUSE_BUTTON_4:      buttonName = "Side_Forward"; break;
-      case GLFW_MOUSE_BUTTON_5:      buttonName = "Side_Backward"; break;
-      default: buttonName = "Unknown"; break;
+  std::string Engine::writeGeneratedShader(const std::string& fileName, const std::string& source) const {
+    const std::filesystem::path directory = std::filesystem::path(cachePath) / "shaders";
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const std::string path = (directory / fileName).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!(file << source)) {
+      Logger::error("Engine", "writeGeneratedShader", "Failed to write " + path);
+      return {};
+    }
+    return path;
+  }
+
+  bool Engine::buildInstancedProgram() {
+    const std::string vertexPath = assetPath + "/shaders/" + VERTEX_SHADER;
+    std::ifstream file(vertexPath, std::ios::binary);
+    const std::string sceneVertex((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::string instancedVertex = InstanceBatcher::instancedVertexSource(sceneVertex);
+    if (instancedVertex.empty())
+      return Logger::error("Engine", "buildInstancedProgram", vertexPath + " declares no \"uniform mat4 model;\", instanced batches will not draw");
+
+    // ShaderManager compiles from files, so the derived stage is written next to the binary cache.
+    const std::string generatedPath = writeGeneratedShader("instanced_vertex.glsl", instancedVertex);
+    bool fromCache = false;
+    const unsigned int program = generatedPath.empty() ? 0
+      : buildProgram(INSTANCED_PROGRAM_NAME, generatedPath, assetPath + "/shaders/" + FRAGMENT_SHADER, fromCache);
+    if (program == 0) return Logger::error("Engine", "buildInstancedProgram", "Failed to build the instanced shader program");
+
+    programCache.registerProgram(INSTANCED_PROGRAM_NAME, program);
+    instanceBatcher.setProgram(program);
+    return true;
+  }
+
+  bool Engine::reloadShaderProgram() {
+    const Clock::Ticks start = Clock::now();
+
+    // The rebuild is only registered once the renderer accepts it, so a
+    // failed compile leaves the running program untouched.
+    bool fromCache = false;
+    const unsigned int program = buildProgram(PROGRAM_NAME, assetPath + "/shaders/" + VERTEX_SHADER, assetPath + "/shaders/" + FRAGMENT_SHADER, fromCache);
+    if (program == 0)
+      return Logger::error("Engine", "reloadShaderProgram", "Shader rebuild failed, keeping previous program");
+
+    const auto previous = glState.getProgram();
+    bool accepted = glState.setProgram(program);
+    for (SceneGraphics* graphics : sceneGraphics)
+      if (accepted && graphics) accepted = graphics->renderer.init(program);
+    if (!accepted) {
+      glState.setProgram(previous);
+      for (SceneGraphics* graphics : sceneGraphics)
+        if (graphics) graphics->renderer.init(previous);
+      glDeleteProgram(program);
+      return Logger::error("Engine", "reloadShaderProgram", "Renderer rejected rebuilt program, keeping previous program");
+    }
+    // Replacing the registration deletes the previous program.
+    programCache.registerProgram(PROGRAM_NAME, program);
+    buildInstancedProgram();
+
+    return Logger::debug("Engine", "reloadShaderProgram", std::string("Reloaded ") + PROGRAM_NAME + (fromCache ? " from binary cache" : " from source")
+      + " in " + std::to_string(Clock::toMilliseconds(Clock::now() - start)) + "ms");
+  }
+
+  void Engine::setOnDemandRendering(const bool enabled) {
+    onDemandRendering = enabled;
+    frameDemand.markDirty();
+  }
+
+  void Engine::requestRedraw(const unsigned int frames) {
+    frameDemand.markDirty(frames);
+    postEmptyEvent();
+  }
+
+  void Engine::requestRedrawAfter(const double seconds) {
+    frameDemand.requestFrameAt(Clock::now() + Clock::fromSeconds(seconds));
+    postEmptyEvent();
+  }
+
+  bool Engine::waitForFrame() {
+    // Replays are paced by their recorded deltas, never by idle waits.
+    if (inputReplay.isOpen()) return true;
+
+    // Coarse caps while background work is outstanding: the watcher and the
+    // loader's worker threads do not wake the event loop themselves.
+    constexpr double WATCH_POLL_SECONDS{ 0.1 };
+    constexpr double LOADER_POLL_SECONDS{ 0.01 };
+
+    const bool wasContinuous = frameDemand.isContinuous();
+    const Clock::Ticks idleStart = Clock::now();
+    bool waited = false;
+    for (;;) {
+      double timeout = frameDemand.getWaitSeconds(Clock::now());
+      if (timeout == 0.0) break;
+
+      const double cap = assetLoader.getPending() > 0 ? LOADER_POLL_SECONDS : assetWatcher.isRunning() ? WATCH_POLL_SECONDS : -1.0;
+      if (cap > 0.0 && (timeout < 0.0 || timeout > cap)) timeout = cap;
+      {
+        STARLET_PROFILE_ZONE("Idle");
+        windowManager.waitEvents(timeout);
+      }
+      waited = true;
+      if (windowManager.shouldClose()) return false;
+
+      if (assetWatcher.isRunning()) applyAssetChanges();
+      if (assetLoader.getPending() > 0) {
+        // Without a render thread the context is here and ready uploads apply
+        // while idle; otherwise the render thread pumps them on the next frame.
+        if (renderThread.isRunning()) frameDemand.markDirty();
+        else if (assetLoader.pump(UPLOAD_BUDGET_MS) > 0) frameDemand.markDirty();
+      }
+    }
+
+    if (!waited) return true;
+    idleTicks += Clock::now() - idleStart;
+    // The pacer measures frame intervals; a wait for demand is not one.
+    framePacer.resetInterval();
+    // An idle gap is not simulated time; only throttled continuous frames keep it.
+    if (!wasContinuous) timer.tick();
+    return true;
+  }
+
+  void Engine::runOnContextThread(RenderThread::Callback command) {
+    // With a render thread the context lives there, so GL work is deferred to it.
+    if (renderThread.isRunning()) renderThread.enqueue(std::move(command));
+    else command();
+  }
+
+  bool Engine::callOnContextThread(RenderThread::Call command) {
+    if (renderThread.isRunning() && !renderThread.isRenderThread()) return renderThread.call(std::move(command));
+    return command();
+  }
+
+  void Engine::updateSimulation(const float deltaTime) {
+    if (!fixedStepEnabled) {
+      // A variable step integrates the whole delta at once, so a long hitch is clamped here.
+      stepSystems(std::min(deltaTime, MAX_VARIABLE_DELTA));
+      inputConsumed = true;
+      return;
+    }
+
+    // Input is sampled once per frame; on frames that run no step, keep it
+    // pending so presses and scroll deltas reach the next simulated step.
+    const unsigned int steps = fixedTimestep.advance(deltaTime);
+    for (unsigned int i = 0; i < steps; ++i) {
+      STARLET_PROFILE_ZONE("FixedStep");
+      stepSystems(fixedTimestep.getStep());
+      // One-shot input (press edges, scroll and mouse deltas) belongs to the
+      // first step only; held state survives the reset for the later steps.
+      if (i == 0 && steps > 1) inputManager.reset();
+    }
+    inputConsumed = steps > 0;
+  }
+
+  void Engine::stepSystems(const float deltaTime) {
+    instanceBatcher.beginStep();
+    {
+      STARLET_PROFILE_ZONE("SceneSystems");
+      sceneManager->getScene().updateSystems(inputManager, deltaTime);
+    }
+    // Engine-scheduled systems run after the scene's own, in conflict-free
+    // phases spread across the job system.
+    frameContext.deltaTime = deltaTime;
+    if (systemScheduler.run(jobSystem, frameContext)) frameDemand.markDirty();
+  }
+
+  void Engine::renderFrame() {
+    STARLET_PROFILE_ZONE("RenderFrame");
+    if (frameCapture.isActive()) frameCapture.beginFrame();
+
+    // Rendering lags the simulation by the unstepped remainder, blended by alpha.
+    const float alpha = frameContext.interpolationAlpha;
+    Scene::Scene& scene = sceneManager->getScene();
+    if (SceneGraphics* graphics = sceneGraphics[slotOf(*sceneManager)]) {
+      if (renderInterpolator) renderInterpolator(scene, alpha);
+      graphics->renderer.renderFrame(glState.getProgram(), scene, windowManager.getAspect());
+      if (renderInterpolator) renderInterpolator(scene, 1.0f);
+    }
+    else glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (!instanceBatcher.empty()) {
+      STARLET_PROFILE_ZONE("InstancedBatches");
+      instanceBatcher.upload(alpha);
+      instanceBatcher.draw(glState.getProgram());
+    }
+
+    if (frameCapture.isActive()) {
+      STARLET_PROFILE_ZONE("FrameCapture");
+      frameCapture.endFrame(frameIndex);
+    }
+  }
+
+  void Engine::presentFrame(const Clock::Ticks inputTimestamp) {
+    {
+      STARLET_PROFILE_ZONE("SwapBuffers");
+      windowManager.swapBuffers();
+    }
+    if (inputTimestamp != 0) inputLatency.record(Clock::toMilliseconds(Clock::now() - inputTimestamp));
+  }
+
+  void Engine::updateViewport(const int width, const int height) {
+    runOnContextThread([this, width, height] { windowManager.updateViewport(width, height); });
+    frameDemand.markDirty();
+  }
+
+  void Engine::onWindowFocus(const bool focused) {
+    frameDemand.setFocused(focused);
+    frameDemand.markDirty();
+  }
+
+  void Engine::onWindowIconify(const bool iconified) {
+    frameDemand.setIconified(iconified);
+  }
+
+  void Engine::toggleWireframe() {
+    runOnContextThread([this] { glState.toggleWireframe(); });
+  }
+
+  bool Engine::startCapture(const CaptureSettings& settings) {
+    if (!hasGraphics()) return Logger::error("Engine", "startCapture", "Frame capture needs a GL context");
+    // Waits for the render thread, so isActive() is settled before the next toggle.
+    return callOnContextThread([this, settings] { return frameCapture.start(settings); });
+  }
+
+  void Engine::stopCapture() {
+    callOnContextThread([this] {
+      frameCapture.stop();
+      return true;
+    });
+  }
+
+  void Engine::toggleFrameCapture() {
+    if (frameCapture.isActive()) {
+      stopCapture();
+      return;
+    }
+
+    CaptureSettings settings;
+    settings.directory = "capture";
+    startCapture(settings);
+  }
+
+  void Engine::toggleTraceCapture() {
+    Profiler& profiler = Profiler::get();
+    if (!profiler.isCapturing()) {
+      profiler.beginCapture();
+      return;
+    }
+
+    profiler.endCapture("starlet_trace.json");
+    const FrameStats& stats = profiler.getFrameStats();
+    Logger::debug("Engine", "toggleTraceCapture", "Frame time p50: " + std::to_string(stats.getP50()) + "ms, p99: " + std::to_string(stats.getP99()) + "ms");
+  }
+
+  bool Engine::startInputRecording(const std::string& path) {
+    inputReplay.close();
+    return inputRecorder.open(path);
+  }
+
+  bool Engine::startInputReplay(const std::string& path, const std::string& timingPath) {
+    inputRecorder.close();
+    return inputReplay.open(path, timingPath);
+  }
+
+  bool Engine::replayInputFrame(float& deltaTime) {
+    if (!inputReplay.next(replayFrame)) return false;
+
+    // The recorded delta replaces the wall clock so fixed-step counts and
+    // variable-step integration match the recorded session exactly.
+    deltaTime = replayFrame.deltaTime;
+
+    GLFWwindow* window = windowManager.getGLFWwindow();
+    if (window) glfwSetCursorPos(window, replayFrame.cursorX, replayFrame.cursorY);
+    inputManager.updateMousePosition(window);
+
+    // Replayed input has no physical press behind it, so it carries no
+    // timestamp and stays out of the input-to-photon latency histogram.
+    for (InputEvent& event : replayFrame.events) {
+      event.timestamp = 0;
+      switch (event.type) {
+      case InputEventType::Key:         inputManager.onKey(event.key); managerEventsQueued = true; break;
+      case InputEventType::MouseButton: inputManager.onButton(event.button); managerEventsQueued = true; break;
+      case InputEventType::Scroll:      inputManager.onScroll(event.scroll); break;
       }
+    }
+    handleInputEvents({ replayFrame.events.data(), replayFrame.events.size() });
+    return true;
+  }
 
-      std::string actionName;
-      switch (event.action) {
-      case GLFW_PRESS:   actionName = "Pressed"; break;
-      case GLFW_RELEASE: actionName = "Released"; break;
-      default: return;
+  void Engine::onKey(const KeyEvent& event) {
+    // A replay ignores live input, except the keys that quit or capture it;
+    // those reach neither the simulation nor the frame demand.
+    if (inputReplay.isOpen()) {
+      if (event.action == GLFW_PRESS && isReplayControlKey(event.key)) handleEngineKey(event.key);
+      return;
+    }
+
+    InputEvent timed{ InputEventType::Key, Clock::now() };
+    timed.key = event;
+    inputEvents.push(timed);
+    inputManager.onKey(event);
+    managerEventsQueued = true;
+    frameDemand.markDirty();
+  }
+  void Engine::onScroll(const Input::ScrollEvent& event) {
+    if (inputReplay.isOpen()) return;
+
+    InputEvent timed{ InputEventType::Scroll, Clock::now() };
+    timed.scroll = event;
+    inputEvents.push(timed);
+    inputManager.onScroll(event);
+    frameDemand.markDirty();
+  }
+  void Engine::onButton(const Input::MouseButtonEvent& event) {
+    if (inputReplay.isOpen()) return;
+
+    InputEvent timed{ InputEventType::MouseButton, Clock::now() };
+    timed.button = event;
+    inputEvents.push(timed);
+    inputManager.onButton(event);
+    managerEventsQueued = true;
+    frameDemand.markDirty();
+  }
+
+  void Engine::handleInputEvents(const InputEventSpan events) {
+    for (const InputEvent& event : events) {
+      if (pendingInputTimestamp == 0) pendingInputTimestamp = event.timestamp;
+
+      switch (event.type) {
+      case InputEventType::Key:         handleKeyEvent(event.key); break;
+      case InputEventType::MouseButton: handleButtonEvent(event.button); break;
+      case InputEventType::Scroll:      break;
       }
+    }
+  }
 
-      Logger::debug("Input", "Mouse", "Button " + buttonName + " " + actionName);
+  void Engine::handleKeyEvent(const KeyEvent& event) {
+    frameDemand.setKeyHeld(event.key, event.action != GLFW_RELEASE);
+    if (event.action == GLFW_PRESS) handleEngineKey(event.key);
+  }
+
+  bool Engine::isReplayControlKey(const int key) {
+    return key == GLFW_KEY_ESCAPE || key == GLFW_KEY_F9 || key == GLFW_KEY_F12;
+  }
+
+  void Engine::handleEngineKey(const int key) {
+    switch (key) {
+    case GLFW_KEY_ESCAPE: windowManager.requestClose(); break;
+
+#ifndef NDEBUG
+    case GLFW_KEY_P: toggleWireframe();  break;
+    case GLFW_KEY_C: toggleCursorLock(); break;
+    case GLFW_KEY_F9: toggleFrameCapture(); break;
+#endif
+#if STARLET_PROFILER_ENABLED
+    case GLFW_KEY_F12: toggleTraceCapture(); break;
+#endif
     }
   }
+
+  void Engine::handleButtonEvent(const Input::MouseButtonEvent& event) {
+    frameDemand.setButtonHeld(event.button, event.action != GLFW_RELEASE);
+#ifndef NDEBUG
+    const char* buttonName = "Unknown";
+    switch (event.button) {
+    case GLFW_MOUSE_BUTTON_LEFT:   buttonName = "Left"; break;
+    case GLFW_MOUSE_BUTTON_RIGHT:  buttonName = "Right"; break;
+    case GLFW_MOUSE_BUTTON_MIDDLE: buttonName = "Middle"; break;
+    case GLFW_MOUSE_BUTTON_4:      buttonName = "Side_Forward"; break;
+    case GLFW_MOUSE_BUTTON_5:      buttonName = "Side_Backward"; break;
+    }
+
+    const char* actionName = nullptr;
+    switch (event.action) {
+    case GLFW_PRESS:   actionName = "Pressed"; break;
+    case GLFW_RELEASE: actionName = "Released"; break;
+    default: return;
+    }
+
+    Logger::debug("Input", "Mouse", std::string("Button ") + buttonName + " " + actionName);
+#else
+    (void)event;
+#endif
+  }
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "starlet-engine/fixed_timestep.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <cmath>
+#include <string>
+
+namespace Starlet::Engine {
+  void FixedTimestep::setTickRate(const double ticksPerSecond) {
+    if (ticksPerSecond <= 0.0) {
+      Logger::error("FixedTimestep", "setTickRate", "Tick rate must be positive, got " + std::to_string(ticksPerSecond));
+      return;
+    }
+
+    step = 1.0 / ticksPerSecond;
+    reset();
+  }
+
+  unsigned int FixedTimestep::advance(const double frameDelta) {
+    accumulator += frameDelta > 0.0 ? frameDelta : 0.0;
+
+    unsigned int steps = static_cast<unsigned int>(accumulator / step);
+    if (steps > maxSteps) {
+      // Spiral-of-death guard: run at most maxSteps and drop the backlog,
+      // keeping only the fractional remainder so alpha stays continuous.
+      Logger::debug("FixedTimestep", "advance", "Dropped " + std::to_string(steps - maxSteps) + " simulation steps");
+      steps = maxSteps;
+      accumulator = std::fmod(accumulator, step) + steps * step;
+    }
+
+    accumulator -= steps * step;
+    alpha = static_cast<float>(accumulator / step);
+    return steps;
+  }
+}
@@ -0,0 +1,96 @@
+#include "starlet-engine/frame_arena.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace Starlet::Engine {
+  namespace {
+    size_t alignUp(const size_t value, const size_t alignment) {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+  }
+
+  FrameArena::FrameArena(const size_t capacityIn)
+    : block(std::make_unique<unsigned char[]>(capacityIn)), capacity(capacityIn) {}
+
+  void* FrameArena::allocate(const size_t size, const size_t alignment) {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.get());
+    const size_t offset = alignUp(base + used, alignment) - base;
+    if (offset + size <= capacity) {
+      used = offset + size;
+      return block.get() + offset;
+    }
+
+    // Spill: a dedicated block, padded so any alignment up to the request fits.
+    overflow.push_back(std::make_unique<unsigned char[]>(size + alignment));
+    overflowUsed += size + alignment;
+    const std::uintptr_t spill = reinterpret_cast<std::uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>(alignUp(spill, alignment));
+  }
+
+  void FrameArena::reset() {
+    lastFrameUsed = used + overflowUsed;
+    highWater = std::max(highWater, lastFrameUsed);
+
+#if STARLET_ARENA_DEBUG
+    std::memset(block.get(), POISON, used);
+#endif
+
+    if (!overflow.empty()) {
+      size_t grown = capacity;
+      while (grown < lastFrameUsed) grown *= 2;
+
+      Logger::debug("FrameArena", "reset", "Frame used " + std::to_string(lastFrameUsed) + " bytes, growing arena to " + std::to_string(grown));
+      overflow.clear();
+      block = std::make_unique<unsigned char[]>(grown);
+      capacity = grown;
+    }
+
+    used = 0;
+    overflowUsed = 0;
+  }
+
+  FrameArenas::FrameArenas(const unsigned int threadCount, const size_t capacityPerThread) {
+    arenas.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+      arenas.emplace_back(capacityPerThread);
+      resources.push_back(std::make_unique<ArenaResource>(arenas.back()));
+    }
+  }
+
+  FrameArena& FrameArenas::get(const unsigned int threadIndex) {
+    if (threadIndex >= arenas.size()) {
+      Logger::error("FrameArenas", "get", "No frame arena for thread index " + std::to_string(threadIndex) + "; only the main thread and job workers have one");
+      std::abort();
+    }
+    return arenas[threadIndex];
+  }
+
+  std::pmr::memory_resource& FrameArenas::getResource(const unsigned int threadIndex) {
+    if (threadIndex >= resources.size()) {
+      Logger::error("FrameArenas", "getResource", "No frame arena for thread index " + std::to_string(threadIndex) + ", falling back to the heap");
+      return *std::pmr::new_delete_resource();
+    }
+    return *resources[threadIndex];
+  }
+
+  void FrameArenas::reset() {
+    for (FrameArena& arena : arenas) arena.reset();
+  }
+
+  size_t FrameArenas::getLastFrameUsed() const {
+    size_t total = 0;
+    for (const FrameArena& arena : arenas) total += arena.getLastFrameUsed();
+    return total;
+  }
+
+  size_t FrameArenas::getHighWater() const {
+    size_t total = 0;
+    for (const FrameArena& arena : arenas) total += arena.getHighWater();
+    return total;
+  }
+}
@@ -0,0 +1,307 @@
+#include "starlet-engine/frame_capture.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace Starlet::Engine {
+  // Upper bound on a blocking fence wait when the ring is full or being flushed.
+  static constexpr GLuint64 FENCE_TIMEOUT_NS{ 1'000'000'000 };
+
+  FrameCapture::~FrameCapture() {
+    if (!active) return;
+    if (glfwGetCurrentContext()) {
+      stop();
+      return;
+    }
+
+    // Without a context the in-flight readbacks are lost; still flush what was queued.
+    if (worker) worker->waitIdle();
+    worker.reset();
+    if (rawStream) std::fclose(rawStream);
+    rawStream = nullptr;
+    active = false;
+  }
+
+  bool FrameCapture::start(const CaptureSettings& settingsIn) {
+    if (active) stop();
+
+    if (!glBlitFramebuffer || !glMapBufferRange || !glGenFramebuffers)
+      return Logger::error("FrameCapture", "start", "Framebuffer blit or buffer mapping unsupported by this context");
+
+    settings = settingsIn;
+    settings.latency = std::max(settings.latency, 1u);
+    settings.maxQueued = std::max(settings.maxQueued, 1u);
+
+    if (settings.format != CaptureFormat::Sink) {
+      std::error_code ec;
+      std::filesystem::create_directories(settings.directory, ec);
+      if (ec) return Logger::error("FrameCapture", "start", "Failed to create capture directory: " + settings.directory);
+    }
+    else if (!settings.sink) return Logger::error("FrameCapture", "start", "Sink format requires a sink");
+
+    if (settings.format == CaptureFormat::Raw) {
+      rawPath = (std::filesystem::path(settings.directory) / "capture.rgba").string();
+      rawStream = std::fopen(rawPath.c_str(), "wb");
+      if (!rawStream) return Logger::error("FrameCapture", "start", "Failed to open for writing: " + rawPath);
+    }
+
+    // Raw frames must land in order, so a single worker owns the stream; a
+    // sink is also promised frames in order.
+    const bool ordered = settings.format != CaptureFormat::Png || settings.sink;
+    worker = std::make_unique<ThreadPool>(ordered ? 1 : std::max(settings.pngThreads, 1u));
+    slots.assign(settings.latency, Slot{});
+    nextSlot = oldestSlot = 0;
+    width = height = 0;
+    rawSegment = 0;
+    bound = false;
+    queued = 0;
+    captured = 0;
+    dropped = 0;
+    stalls = 0;
+    active = true;
+
+    return Logger::debug("FrameCapture", "start", std::string("Capturing with ") + (glFenceSync ? "fenced" : "unfenced")
+      + " readback, latency " + std::to_string(settings.latency) + " frames");
+  }
+
+  void FrameCapture::stop() {
+    if (!active) return;
+
+    // Drain every readback still in flight, letting the worker catch up so
+    // the tail of the capture is not dropped, then finish encoding.
+    for (size_t i = 0; i < slots.size(); ++i) {
+      worker->waitIdle();
+      collect(true);
+    }
+    worker->waitIdle();
+    worker.reset();
+
+    if (rawStream) std::fclose(rawStream);
+    rawStream = nullptr;
+
+    releaseTargets();
+    for (const Slot& slot : slots)
+      if (slot.buffer != 0) glDeleteBuffers(1, &slot.buffer);
+    slots.clear();
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      freeBuffers.clear();
+    }
+    active = false;
+
+    Logger::debug("FrameCapture", "stop", "Captured " + std::to_string(captured.load()) + " frames, dropped "
+      + std::to_string(dropped.load()) + ", stalled " + std::to_string(stalls));
+  }
+
+  void FrameCapture::releaseTargets() {
+    if (framebuffer != 0) glDeleteFramebuffers(1, &framebuffer);
+    if (colorBuffer != 0) glDeleteRenderbuffers(1, &colorBuffer);
+    if (depthBuffer != 0) glDeleteRenderbuffers(1, &depthBuffer);
+    framebuffer = colorBuffer = depthBuffer = 0;
+  }
+
+  void FrameCapture::startRawSegment(const unsigned int segmentWidth, const unsigned int segmentHeight) {
+    // Queued behind the old size's frames on the single worker, so each file holds one frame size.
+    rawPath = (std::filesystem::path(settings.directory) / ("capture_" + std::to_string(++rawSegment) + ".rgba")).string();
+    worker->submit([this, path = rawPath, segmentWidth, segmentHeight] {
+      if (rawStream) std::fclose(rawStream);
+      rawStream = std::fopen(path.c_str(), "wb");
+      if (!rawStream) Logger::error("FrameCapture", "resize", "Failed to open for writing: " + path);
+      else Logger::debug("FrameCapture", "resize", "Raw capture continues at " + std::to_string(segmentWidth) + "x" + std::to_string(segmentHeight) + " in " + path);
+    });
+    writeRawSidecar(segmentWidth, segmentHeight);
+  }
+
+  void FrameCapture::writeRawSidecar(const unsigned int segmentWidth, const unsigned int segmentHeight) {
+    // Raw files carry no header, so the frame size goes next to them.
+    const std::string path = std::filesystem::path(rawPath).replace_extension(".txt").string();
+    worker->submit([path, segmentWidth, segmentHeight] {
+      FILE* file = std::fopen(path.c_str(), "wb");
+      if (!file) {
+        Logger::error("FrameCapture", "writeRawSidecar", "Failed to open for writing: " + path);
+        return;
+      }
+      std::fprintf(file, "width=%u\nheight=%u\npixel_format=rgba\nrow_order=bottom_up\n", segmentWidth, segmentHeight);
+      std::fclose(file);
+    });
+  }
+
+  bool FrameCapture::resize(const unsigned int widthIn, const unsigned int heightIn) {
+    // Readbacks in flight were sized for the old target.
+    for (size_t i = 0; i < slots.size(); ++i) collect(true);
+    releaseTargets();
+    if (settings.format == CaptureFormat::Raw) {
+      if (width != 0) startRawSegment(widthIn, heightIn);
+      else writeRawSidecar(widthIn, heightIn);
+    }
+
+    width = widthIn;
+    height = heightIn;
+    const GLsizei w = static_cast<GLsizei>(width), h = static_cast<GLsizei>(height);
+
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    if (!complete) {
+      releaseTargets();
+      width = height = 0;
+      return Logger::error("FrameCapture", "resize", "Capture framebuffer incomplete");
+    }
+
+    const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(width) * height * 4;
+    for (Slot& slot : slots) {
+      if (slot.buffer == 0) glGenBuffers(1, &slot.buffer);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+      glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+  }
+
+  void FrameCapture::beginFrame() {
+    if (!active) return;
+
+    GLint viewport[4] = {};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (viewport[2] <= 0 || viewport[3] <= 0) return;
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    const unsigned int w = static_cast<unsigned int>(viewport[2]), h = static_cast<unsigned int>(viewport[3]);
+    if ((w != width || h != height || framebuffer == 0) && !resize(w, h)) return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    bound = true;
+  }
+
+  void FrameCapture::endFrame(const unsigned long long frameIndex) {
+    // A frame drawn while minimised or after a failed resize went straight to the window.
+    if (!active || !bound) return;
+    bound = false;
+
+    const GLint w = static_cast<GLint>(width), h = static_cast<GLint>(height);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    // Map whatever has already landed; only block when the ring has wrapped.
+    collect(false);
+    if (slots[nextSlot].pending) {
+      // An unfenced ring always maps at this point, which is expected rather than a stall.
+      if (slots[nextSlot].fence) ++stalls;
+      collect(true);
+    }
+
+    Slot& slot = slots[nextSlot];
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+    slot.frameIndex = frameIndex;
+    slot.pending = true;
+    nextSlot = (nextSlot + 1) % slots.size();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+  }
+
+  void FrameCapture::collect(const bool wait) {
+    bool block = wait;
+    while (slots[oldestSlot].pending) {
+      Slot& slot = slots[oldestSlot];
+      if (slot.fence) {
+        const GLenum status = glClientWaitSync(static_cast<GLsync>(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT, block ? FENCE_TIMEOUT_NS : 0);
+        if (status == GL_TIMEOUT_EXPIRED && !block) break;
+      }
+      // Unfenced readbacks give no completion signal, so they are only mapped once the ring is full.
+      else if (!block) break;
+
+      readSlot(slot);
+      oldestSlot = (oldestSlot + 1) % slots.size();
+      block = false;
+    }
+  }
+
+  void FrameCapture::readSlot(Slot& slot) {
+    if (slot.fence) glDeleteSync(static_cast<GLsync>(slot.fence));
+    slot.fence = nullptr;
+    slot.pending = false;
+
+    if (queued.load() >= settings.maxQueued) {
+      ++dropped;
+      return;
+    }
+
+    const size_t frameBytes = size_t{ width } * height * 4;
+    std::vector<unsigned char> pixels;
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      if (!freeBuffers.empty()) {
+        pixels = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+      }
+    }
+    pixels.resize(frameBytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes), GL_MAP_READ_BIT);
+    if (!mapped) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+      ++dropped;
+      Logger::error("FrameCapture", "readSlot", "Failed to map readback buffer for frame " + std::to_string(slot.frameIndex));
+      return;
+    }
+    std::memcpy(pixels.data(), mapped, frameBytes);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    ++queued;
+    worker->submit([this, buffer = std::move(pixels), index = slot.frameIndex, w = width, h = height]() mutable {
+      encode(std::move(buffer), index, w, h);
+    });
+  }
+
+  void FrameCapture::encode(std::vector<unsigned char> pixels, const unsigned long long frameIndex, const unsigned int frameWidth, const unsigned int frameHeight) {
+    bool ok = true;
+    switch (settings.format) {
+    case CaptureFormat::Raw:
+      ok = rawStream && std::fwrite(pixels.data(), pixels.size(), 1, rawStream) == 1;
+      if (!ok) Logger::error("FrameCapture", "encode", "Failed to append frame " + std::to_string(frameIndex) + " to raw stream");
+      break;
+    case CaptureFormat::Png: {
+      char name[32];
+      std::snprintf(name, sizeof(name), "frame_%06llu.png", frameIndex);
+      ok = writePng((std::filesystem::path(settings.directory) / name).string(), frameWidth, frameHeight, pixels.data(), true, settings.pngCompression);
+      break;
+    }
+    case CaptureFormat::Sink:
+      break;
+    }
+
+    if (settings.sink) settings.sink(CapturedFrame{ frameIndex, frameWidth, frameHeight, pixels.data() });
+    if (ok) ++captured;
+    else ++dropped;
+
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      freeBuffers.push_back(std::move(pixels));
+    }
+    --queued;
+  }
+}
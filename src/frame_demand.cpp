@@ -0,0 +1,61 @@
+#include "starlet-engine/frame_demand.hpp"
+
+#include <algorithm>
+
+namespace Starlet::Engine {
+  void FrameDemand::markDirty(const unsigned int frames) {
+    unsigned int current = pendingFrames.load();
+    while (current < frames && !pendingFrames.compare_exchange_weak(current, frames)) {}
+  }
+
+  void FrameDemand::requestFrameAt(const Clock::Ticks when) {
+    Clock::Ticks current = deadline.load();
+    while ((current == 0 || when < current) && !deadline.compare_exchange_weak(current, when)) {}
+  }
+
+  void FrameDemand::endAnimation() {
+    int current = animations.load();
+    while (current > 0 && !animations.compare_exchange_weak(current, current - 1)) {}
+    // One more frame so the final animated state is shown.
+    markDirty();
+  }
+
+  void FrameDemand::setHeld(std::vector<int>& held, const int code, const bool isHeld) {
+    const auto it = std::find(held.begin(), held.end(), code);
+    if (isHeld && it == held.end()) held.push_back(code);
+    else if (!isHeld && it != held.end()) held.erase(it);
+  }
+
+  void FrameDemand::setIconified(const bool iconifiedIn) {
+    iconified = iconifiedIn;
+    // Releases are not delivered while minimised, and a restored window needs repainting.
+    if (iconified) {
+      heldKeys.clear();
+      heldButtons.clear();
+    }
+    else markDirty();
+  }
+
+  double FrameDemand::getWaitSeconds(const Clock::Ticks now) const {
+    if (iconified) return -1.0;
+
+    Clock::Ticks due = 0;
+    if (pendingFrames.load() > 0 || isContinuous()) due = now;
+    else if (const Clock::Ticks timer = deadline.load(); timer != 0) due = timer;
+    else return -1.0;
+
+    if (!focused && backgroundInterval > 0 && lastFrame != 0)
+      due = std::max(due, lastFrame + backgroundInterval);
+    return due <= now ? 0.0 : Clock::toSeconds(due - now);
+  }
+
+  void FrameDemand::beginFrame(const Clock::Ticks now) {
+    lastFrame = now;
+
+    unsigned int frames = pendingFrames.load();
+    while (frames > 0 && !pendingFrames.compare_exchange_weak(frames, frames - 1)) {}
+
+    Clock::Ticks timer = deadline.load();
+    while (timer != 0 && timer <= now && !deadline.compare_exchange_weak(timer, 0)) {}
+  }
+}
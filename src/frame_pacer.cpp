@@ -0,0 +1,96 @@
+#include "starlet-engine/frame_pacer.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace Starlet::Engine {
+  static constexpr Clock::Ticks MIN_SPIN_MARGIN{ 200'000 };
+  static constexpr Clock::Ticks MAX_SPIN_MARGIN{ 4'000'000 };
+
+  void FramePacer::setMode(const PresentMode modeIn, const double targetFps) {
+    if (modeIn == PresentMode::Limited && targetFps <= 0.0) {
+      Logger::error("FramePacer", "setMode", "Limited mode needs a positive target FPS, got " + std::to_string(targetFps));
+      return;
+    }
+
+    mode = modeIn;
+    period = mode == PresentMode::Limited ? Clock::fromSeconds(1.0 / targetFps) : 0;
+    nextDeadline = 0;
+  }
+
+  int FramePacer::getSwapInterval() const {
+    switch (mode) {
+    case PresentMode::VSync:    return 1;
+    case PresentMode::Adaptive: return -1;
+    case PresentMode::Uncapped:
+    case PresentMode::Limited:  return 0;
+    }
+    return 1;
+  }
+
+  void FramePacer::resetInterval() {
+    lastFrameEnd = 0;
+    nextDeadline = 0;
+  }
+
+  void FramePacer::resetStats() {
+    frameTimes.clear();
+    missedDeadlines = 0;
+  }
+
+  Clock::Ticks FramePacer::getExpectedInterval() const {
+    switch (mode) {
+    case PresentMode::VSync:
+    case PresentMode::Adaptive: return Clock::fromSeconds(1.0 / refreshRate);
+    case PresentMode::Limited:  return period;
+    case PresentMode::Uncapped: return 0;
+    }
+    return 0;
+  }
+
+  void FramePacer::waitUntil(const Clock::Ticks deadline) {
+    Clock::Ticks now = Clock::now();
+    if (deadline - now > spinMargin) {
+      const Clock::Ticks sleepTarget = deadline - spinMargin;
+      std::this_thread::sleep_for(std::chrono::nanoseconds(sleepTarget - now));
+
+      // Widen the margin quickly when the sleep overshoots, narrow it slowly otherwise.
+      const Clock::Ticks overshoot = Clock::now() - sleepTarget;
+      spinMargin = overshoot > spinMargin / 2
+        ? std::min(MAX_SPIN_MARGIN, spinMargin + overshoot)
+        : std::max(MIN_SPIN_MARGIN, spinMargin - spinMargin / 16);
+    }
+
+    while ((now = Clock::now()) < deadline) std::this_thread::yield();
+  }
+
+  void FramePacer::endFrame() {
+    if (mode == PresentMode::Limited) {
+      const Clock::Ticks now = Clock::now();
+      if (nextDeadline == 0) nextDeadline = now + period;
+
+      if (now > nextDeadline) {
+        // Late: count it and re-anchor instead of rushing to catch up.
+        ++missedDeadlines;
+        nextDeadline = now + period;
+      }
+      else {
+        waitUntil(nextDeadline);
+        nextDeadline += period;
+      }
+    }
+
+    const Clock::Ticks frameEnd = Clock::now();
+    if (lastFrameEnd != 0) {
+      const Clock::Ticks interval = frameEnd - lastFrameEnd;
+      frameTimes.record(Clock::toMilliseconds(interval));
+
+      // With vsync a frame that took more than 1.5 refresh intervals missed its vblank.
+      const Clock::Ticks expected = getExpectedInterval();
+      if (mode != PresentMode::Limited && expected > 0 && interval > expected + expected / 2) ++missedDeadlines;
+    }
+    lastFrameEnd = frameEnd;
+  }
+}
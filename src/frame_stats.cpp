@@ -0,0 +1,30 @@
+#include "starlet-engine/frame_stats.hpp"
+
+#include <algorithm>
+
+namespace Starlet::Engine {
+  void FrameStats::record(const double milliseconds) {
+    samples[next] = milliseconds;
+    next = (next + 1) % WINDOW;
+    if (count < WINDOW) ++count;
+  }
+
+  double FrameStats::getPercentile(const double percentile) const {
+    if (count == 0) return 0.0;
+
+    std::copy(samples.begin(), samples.begin() + count, scratch.begin());
+    const double clamped = std::clamp(percentile, 0.0, 1.0);
+    const size_t index = std::min(count - 1, static_cast<size_t>(clamped * static_cast<double>(count - 1) + 0.5));
+
+    std::nth_element(scratch.begin(), scratch.begin() + index, scratch.begin() + count);
+    return scratch[index];
+  }
+
+  double FrameStats::getAverage() const {
+    if (count == 0) return 0.0;
+
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) total += samples[i];
+    return total / static_cast<double>(count);
+  }
+}
@@ -0,0 +1,139 @@
+#include "starlet-engine/input_log.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Starlet::Engine {
+  static_assert(std::is_trivially_copyable_v<KeyEvent>, "KeyEvent is logged as raw bytes");
+  static_assert(std::is_trivially_copyable_v<Input::MouseButtonEvent>, "MouseButtonEvent is logged as raw bytes");
+  static_assert(std::is_trivially_copyable_v<Input::ScrollEvent>, "ScrollEvent is logged as raw bytes");
+
+  namespace {
+    struct FrameRecord {
+      float deltaTime;
+      std::uint32_t eventCount;
+      double cursorX;
+      double cursorY;
+    };
+
+    constexpr InputLogHeader currentHeader() {
+      return { InputRecorder::MAGIC, InputRecorder::FORMAT_VERSION,
+        sizeof(KeyEvent), sizeof(Input::MouseButtonEvent), sizeof(Input::ScrollEvent), 0 };
+    }
+
+    size_t payloadSize(const InputEventType type) {
+      switch (type) {
+      case InputEventType::Key:         return sizeof(KeyEvent);
+      case InputEventType::MouseButton: return sizeof(Input::MouseButtonEvent);
+      case InputEventType::Scroll:      return sizeof(Input::ScrollEvent);
+      }
+      return 0;
+    }
+  }
+
+  bool InputRecorder::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return Logger::error("InputRecorder", "open", "Failed to open input log: " + path);
+
+    // Large buffer so recording costs a memcpy per frame, not a syscall.
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+    const InputLogHeader header = currentHeader();
+    std::fwrite(&header, sizeof(header), 1, file);
+    frames = 0;
+    return Logger::debug("InputRecorder", "open", "Recording input to " + path);
+  }
+
+  void InputRecorder::close() {
+    if (!file) return;
+
+    std::fclose(file);
+    file = nullptr;
+    Logger::debug("InputRecorder", "close", "Recorded " + std::to_string(frames) + " frame(s)");
+  }
+
+  void InputRecorder::recordFrame(const float deltaTime, const double cursorX, const double cursorY, const InputEventSpan events) {
+    if (!file) return;
+
+    const FrameRecord record{ deltaTime, static_cast<std::uint32_t>(events.size), cursorX, cursorY };
+    std::fwrite(&record, sizeof(record), 1, file);
+
+    for (const InputEvent& event : events) {
+      const std::uint8_t type = static_cast<std::uint8_t>(event.type);
+      std::fwrite(&type, 1, 1, file);
+      switch (event.type) {
+      case InputEventType::Key:         std::fwrite(&event.key, sizeof(event.key), 1, file); break;
+      case InputEventType::MouseButton: std::fwrite(&event.button, sizeof(event.button), 1, file); break;
+      case InputEventType::Scroll:      std::fwrite(&event.scroll, sizeof(event.scroll), 1, file); break;
+      }
+    }
+    ++frames;
+  }
+
+  bool InputReplay::open(const std::string& path, const std::string& timingPath) {
+    close();
+    if (!log.open(path)) return Logger::error("InputReplay", "open", "Failed to open input log: " + path);
+
+    InputLogHeader header{};
+    const InputLogHeader expected = currentHeader();
+    if (log.size() >= sizeof(header)) std::memcpy(&header, log.data(), sizeof(header));
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+      log.close();
+      return Logger::error("InputReplay", "open", "Input log is from an incompatible build: " + path);
+    }
+
+    if (!timingPath.empty()) {
+      timing = std::fopen(timingPath.c_str(), "w");
+      if (timing) std::fprintf(timing, "frame,delta_ms,update_ms,frame_ms\n");
+      else Logger::error("InputReplay", "open", "Failed to open timing output: " + timingPath);
+    }
+
+    cursor = sizeof(header);
+    frames = 0;
+    return Logger::debug("InputReplay", "open", "Replaying input from " + path);
+  }
+
+  void InputReplay::close() {
+    log.close();
+    if (timing) std::fclose(timing);
+    timing = nullptr;
+  }
+
+  bool InputReplay::next(InputLogFrame& frame) {
+    if (!log.isOpen() || cursor + sizeof(FrameRecord) > log.size()) return false;
+
+    FrameRecord record;
+    std::memcpy(&record, log.data() + cursor, sizeof(record));
+    size_t position = cursor + sizeof(record);
+
+    frame.deltaTime = record.deltaTime;
+    frame.cursorX = record.cursorX;
+    frame.cursorY = record.cursorY;
+    frame.events.resize(record.eventCount);
+    for (InputEvent& event : frame.events) {
+      if (position + 1 > log.size()) return false;
+      event = InputEvent{};
+      event.type = static_cast<InputEventType>(log.data()[position++]);
+
+      const size_t size = payloadSize(event.type);
+      if (size == 0 || position + size > log.size())
+        return Logger::error("InputReplay", "next", "Input log truncated or corrupt at frame " + std::to_string(frames));
+
+      void* payload = event.type == InputEventType::Key ? static_cast<void*>(&event.key)
+        : event.type == InputEventType::MouseButton ? static_cast<void*>(&event.button)
+        : static_cast<void*>(&event.scroll);
+      std::memcpy(payload, log.data() + position, size);
+      position += size;
+    }
+
+    cursor = position;
+    lastDelta = record.deltaTime;
+    ++frames;
+    return true;
+  }
+
+  void InputReplay::recordTiming(const double updateMs, const double frameMs) {
+    if (timing) std::fprintf(timing, "%llu,%.4f,%.4f,%.4f\n", static_cast<unsigned long long>(frames - 1), lastDelta * 1000.0, updateMs, frameMs);
+  }
+}
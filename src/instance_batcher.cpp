@@ -0,0 +1,377 @@
+#include "starlet-engine/instance_batcher.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace Starlet::Engine {
+  static constexpr size_t MATRIX_FLOATS{ 16 };
+  static constexpr size_t MATRIX_BYTES{ MATRIX_FLOATS * sizeof(float) };
+  // Clean gaps shorter than this are uploaded with their neighbours rather
+  // than splitting the write into another glBufferSubData call.
+  static constexpr size_t MERGE_GAP{ 32 };
+
+  std::uint32_t packColour(const float r, const float g, const float b, const float a) {
+    const auto channel = [](const float value) { return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return (channel(r) << 24) | (channel(g) << 16) | (channel(b) << 8) | channel(a);
+  }
+
+  // Reads the identifier-like token at pos after skipping whitespace; pos ends past it.
+  static std::string nextToken(const std::string& source, size_t& pos) {
+    while (pos < source.size() && std::isspace(static_cast<unsigned char>(source[pos]))) ++pos;
+    const size_t begin = pos;
+    while (pos < source.size() && (std::isalnum(static_cast<unsigned char>(source[pos])) || source[pos] == '_')) ++pos;
+    if (pos == begin && pos < source.size()) ++pos;
+    return source.substr(begin, pos - begin);
+  }
+
+  std::string InstanceBatcher::instancedVertexSource(const std::string& sceneVertexSource, const std::string& modelUniform, const unsigned int location) {
+    // Finds "uniform [precision] mat4 <modelUniform>;".
+    size_t begin = std::string::npos, end = 0;
+    for (size_t found = sceneVertexSource.find("uniform"); found != std::string::npos; found = sceneVertexSource.find("uniform", found + 1)) {
+      if (found > 0 && (std::isalnum(static_cast<unsigned char>(sceneVertexSource[found - 1])) || sceneVertexSource[found - 1] == '_')) continue;
+      size_t pos = found;
+      nextToken(sceneVertexSource, pos);
+      std::string token = nextToken(sceneVertexSource, pos);
+      if (token == "highp" || token == "mediump" || token == "lowp") token = nextToken(sceneVertexSource, pos);
+      if (token != "mat4" || nextToken(sceneVertexSource, pos) != modelUniform || nextToken(sceneVertexSource, pos) != ";") continue;
+      begin = found;
+      end = pos;
+      break;
+    }
+    if (begin == std::string::npos) return {};
+
+    // GLSL before 1.30 has no "in", and before 3.30 needs the extension for layout().
+    int version = 110;
+    size_t versionEnd = std::string::npos;
+    const size_t directive = sceneVertexSource.find("#version");
+    if (directive != std::string::npos) {
+      version = std::atoi(sceneVertexSource.c_str() + directive + 8);
+      versionEnd = sceneVertexSource.find('\n', directive);
+      versionEnd = versionEnd == std::string::npos ? sceneVertexSource.size() : versionEnd + 1;
+    }
+
+    std::string source = sceneVertexSource.substr(0, begin)
+      + "layout(location = " + std::to_string(location) + ") " + (version >= 130 ? "in" : "attribute") + " mat4 " + modelUniform + ";"
+      + sceneVertexSource.substr(end);
+    if (version < 330 && source.find("GL_ARB_explicit_attrib_location") == std::string::npos) {
+      const std::string extension = "#extension GL_ARB_explicit_attrib_location : require\n";
+      source.insert(versionEnd == std::string::npos ? 0 : versionEnd, extension);
+    }
+    return source;
+  }
+
+  InstanceBatcher::~InstanceBatcher() {
+    if (!glfwGetCurrentContext()) return;
+    for (const auto& batch : batches)
+      if (batch->buffer != 0) glDeleteBuffers(1, &batch->buffer);
+  }
+
+  void InstanceBatcher::growDirty(Batch& batch, const size_t count) {
+    if (count <= batch.dirtyCapacity) return;
+
+    const size_t capacity = std::max(count, batch.dirtyCapacity * 2);
+    auto grown = std::make_unique<std::atomic<std::uint8_t>[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i) grown[i].store(i < batch.dirtyCapacity ? batch.dirty[i].load(std::memory_order_relaxed) : 0, std::memory_order_relaxed);
+    batch.dirty = std::move(grown);
+    batch.dirtyCapacity = capacity;
+  }
+
+  void InstanceBatcher::setProgram(const unsigned int instancedProgram) {
+    program = instancedProgram;
+    copiedTo = 0;
+  }
+
+  void InstanceBatcher::setMaterialUniforms(std::string texture, std::string useTexture, std::string colour) {
+    textureUniform = std::move(texture);
+    useTextureUniform = std::move(useTexture);
+    colourUniform = std::move(colour);
+    copiedTo = 0;
+  }
+
+  InstanceRef InstanceBatcher::add(const InstanceBatchKey& key, const float* transform) {
+    auto [it, inserted] = batchIndex.emplace(key, static_cast<std::uint32_t>(batches.size()));
+    if (inserted) {
+      batches.push_back(std::make_unique<Batch>());
+      batches.back()->key = key;
+    }
+
+    Batch& batch = *batches[it->second];
+    const size_t slot = batch.transforms.size() / MATRIX_FLOATS;
+    batch.transforms.insert(batch.transforms.end(), transform, transform + MATRIX_FLOATS);
+    batch.previous.insert(batch.previous.end(), transform, transform + MATRIX_FLOATS);
+    batch.movedStep.push_back(0);
+    growDirty(batch, slot + 1);
+    batch.dirty[slot].store(1, std::memory_order_relaxed);
+    batch.anyDirty.store(true, std::memory_order_relaxed);
+
+    ++instanceCount;
+    return { it->second, static_cast<std::uint32_t>(slot), generation };
+  }
+
+  bool InstanceBatcher::setTransform(const InstanceRef instance, const float* transform) {
+    if (instance.generation != generation || instance.batch >= batches.size()) return false;
+    Batch& batch = *batches[instance.batch];
+    if (instance.slot >= batch.transforms.size() / MATRIX_FLOATS) return false;
+
+    // The first move in a step keeps where the instance was, to blend from.
+    float* current = batch.transforms.data() + size_t{ instance.slot } * MATRIX_FLOATS;
+    if (batch.movedStep[instance.slot] != step) {
+      std::memcpy(batch.previous.data() + size_t{ instance.slot } * MATRIX_FLOATS, current, MATRIX_BYTES);
+      batch.movedStep[instance.slot] = step;
+      batch.anyMoving.store(true, std::memory_order_relaxed);
+    }
+    std::memcpy(current, transform, MATRIX_BYTES);
+    batch.dirty[instance.slot].store(1, std::memory_order_relaxed);
+    batch.anyDirty.store(true, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool InstanceBatcher::getInterpolatedTransform(const InstanceRef instance, const float alpha, float* out) const {
+    if (instance.generation != generation || instance.batch >= batches.size()) return false;
+    const Batch& batch = *batches[instance.batch];
+    if (instance.slot >= batch.transforms.size() / MATRIX_FLOATS) return false;
+
+    blend(batch, instance.slot, alpha, out);
+    return true;
+  }
+
+  void InstanceBatcher::blend(const Batch& batch, const size_t slot, const float alpha, float* out) const {
+    const float* current = batch.transforms.data() + slot * MATRIX_FLOATS;
+    if (batch.movedStep[slot] != step || alpha >= 1.0f) {
+      std::memcpy(out, current, MATRIX_BYTES);
+      return;
+    }
+    const float* previous = batch.previous.data() + slot * MATRIX_FLOATS;
+    for (size_t i = 0; i < MATRIX_FLOATS; ++i) out[i] = previous[i] + (current[i] - previous[i]) * alpha;
+  }
+
+  void InstanceBatcher::beginStep() {
+    // Instances that moved in the step just finished settle on their latest
+    // transform unless they move again.
+    for (const auto& batch : batches) {
+      if (!batch->anyMoving.exchange(false, std::memory_order_relaxed)) continue;
+      const size_t count = batch->transforms.size() / MATRIX_FLOATS;
+      for (size_t i = 0; i < count; ++i)
+        if (batch->movedStep[i] == step) batch->dirty[i].store(1, std::memory_order_relaxed);
+      batch->anyDirty.store(true, std::memory_order_relaxed);
+    }
+    ++step;
+  }
+
+  void InstanceBatcher::clear() {
+    for (const auto& batch : batches) {
+      batch->transforms.clear();
+      batch->previous.clear();
+      batch->movedStep.clear();
+      batch->anyDirty.store(false, std::memory_order_relaxed);
+      batch->anyMoving.store(false, std::memory_order_relaxed);
+    }
+    instanceCount = 0;
+    ++generation;
+  }
+
+  void InstanceBatcher::upload(const float alpha) {
+    uploadBytes = 0;
+    for (const auto& batch : batches) {
+      // Moving instances are redrawn every frame, since alpha changes between steps.
+      const bool dirty = batch->anyDirty.exchange(false, std::memory_order_acquire);
+      if (dirty || batch->anyMoving.load(std::memory_order_relaxed)) uploadBatch(*batch, alpha);
+    }
+  }
+
+  void InstanceBatcher::uploadBatch(Batch& batch, const float alpha) {
+    const size_t count = batch.transforms.size() / MATRIX_FLOATS;
+    if (count == 0) return;
+
+    batch.rendered.resize(batch.transforms.size());
+    const bool growing = count > batch.bufferCapacity;
+    for (size_t i = 0; i < count; ++i) {
+      if (batch.movedStep[i] == step) batch.dirty[i].store(1, std::memory_order_relaxed);
+      if (growing || batch.dirty[i].load(std::memory_order_relaxed)) blend(batch, i, alpha, batch.rendered.data() + i * MATRIX_FLOATS);
+    }
+
+    if (batch.buffer == 0) glGenBuffers(1, &batch.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, batch.buffer);
+
+    // Growing reallocates, so everything is rewritten; otherwise only dirty runs are.
+    if (growing) {
+      batch.bufferCapacity = std::max(count, batch.bufferCapacity * 2);
+      glBufferData(GL_ARRAY_BUFFER, batch.bufferCapacity * MATRIX_BYTES, nullptr, GL_DYNAMIC_DRAW);
+      glBufferSubData(GL_ARRAY_BUFFER, 0, count * MATRIX_BYTES, batch.rendered.data());
+      for (size_t i = 0; i < count; ++i) batch.dirty[i].store(0, std::memory_order_relaxed);
+      uploadBytes += count * MATRIX_BYTES;
+      return;
+    }
+
+    size_t i = 0;
+    while (i < count) {
+      if (!batch.dirty[i].load(std::memory_order_relaxed)) {
+        ++i;
+        continue;
+      }
+
+      const size_t begin = i;
+      size_t end = i + 1;
+      for (size_t clean = 0; i < count && clean < MERGE_GAP; ++i) {
+        if (batch.dirty[i].exchange(0, std::memory_order_relaxed)) {
+          end = i + 1;
+          clean = 0;
+        }
+        else ++clean;
+      }
+
+      glBufferSubData(GL_ARRAY_BUFFER, begin * MATRIX_BYTES, (end - begin) * MATRIX_BYTES, batch.rendered.data() + begin * MATRIX_FLOATS);
+      uploadBytes += (end - begin) * MATRIX_BYTES;
+      i = end;
+    }
+  }
+
+  void InstanceBatcher::mapUniforms(const unsigned int sceneProgram) {
+    uniformCopies.clear();
+    copiedFrom = sceneProgram;
+    copiedTo = program;
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(sceneProgram, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(sceneProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(static_cast<size_t>(std::max(maxLength, 1)));
+    for (GLint i = 0; i < count; ++i) {
+      GLsizei length = 0;
+      GLint size = 0;
+      GLenum type = 0;
+      glGetActiveUniform(sceneProgram, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+      // Arrays are reported once as "name[0]"; each element has its own location.
+      std::string base(name.data(), static_cast<size_t>(length));
+      if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0) base.resize(base.size() - 3);
+      for (GLint element = 0; element < size; ++element) {
+        const std::string elementName = size > 1 ? base + "[" + std::to_string(element) + "]" : base;
+        const GLint from = glGetUniformLocation(sceneProgram, elementName.c_str());
+        const GLint to = glGetUniformLocation(program, elementName.c_str());
+        if (from >= 0 && to >= 0) uniformCopies.push_back({ from, to, type });
+      }
+    }
+
+    textureLocation = textureUniform.empty() ? -1 : glGetUniformLocation(program, textureUniform.c_str());
+    useTextureLocation = useTextureUniform.empty() ? -1 : glGetUniformLocation(program, useTextureUniform.c_str());
+    colourLocation = -1;
+    colourType = 0;
+    if (colourUniform.empty()) return;
+
+    // The colour is written as a vec3 or a vec4, whichever the shader declares.
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    name.resize(static_cast<size_t>(std::max(maxLength, 1)));
+    for (GLint i = 0; i < count; ++i) {
+      GLsizei length = 0;
+      GLint size = 0;
+      GLenum type = 0;
+      glGetActiveUniform(program, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+      if (colourUniform.compare(0, std::string::npos, name.data(), static_cast<size_t>(length)) != 0) continue;
+      if (type == GL_FLOAT_VEC3 || type == GL_FLOAT_VEC4) {
+        colourLocation = glGetUniformLocation(program, colourUniform.c_str());
+        colourType = type;
+      }
+      break;
+    }
+  }
+
+  void InstanceBatcher::copyUniforms() const {
+    GLfloat floats[MATRIX_FLOATS];
+    GLint ints[4];
+    GLuint uints[4];
+    for (const UniformCopy& copy : uniformCopies) {
+      switch (copy.type) {
+      case GL_FLOAT:        glGetUniformfv(copiedFrom, copy.from, floats); glUniform1fv(copy.to, 1, floats); break;
+      case GL_FLOAT_VEC2:   glGetUniformfv(copiedFrom, copy.from, floats); glUniform2fv(copy.to, 1, floats); break;
+      case GL_FLOAT_VEC3:   glGetUniformfv(copiedFrom, copy.from, floats); glUniform3fv(copy.to, 1, floats); break;
+      case GL_FLOAT_VEC4:   glGetUniformfv(copiedFrom, copy.from, floats); glUniform4fv(copy.to, 1, floats); break;
+      case GL_FLOAT_MAT2:   glGetUniformfv(copiedFrom, copy.from, floats); glUniformMatrix2fv(copy.to, 1, GL_FALSE, floats); break;
+      case GL_FLOAT_MAT3:   glGetUniformfv(copiedFrom, copy.from, floats); glUniformMatrix3fv(copy.to, 1, GL_FALSE, floats); break;
+      case GL_FLOAT_MAT4:   glGetUniformfv(copiedFrom, copy.from, floats); glUniformMatrix4fv(copy.to, 1, GL_FALSE, floats); break;
+      case GL_INT:
+      case GL_BOOL:
+      case GL_SAMPLER_1D:
+      case GL_SAMPLER_2D:
+      case GL_SAMPLER_3D:
+      case GL_SAMPLER_CUBE:
+      case GL_SAMPLER_2D_SHADOW:
+      case GL_SAMPLER_2D_ARRAY:
+                            glGetUniformiv(copiedFrom, copy.from, ints); glUniform1iv(copy.to, 1, ints); break;
+      case GL_INT_VEC2:
+      case GL_BOOL_VEC2:    glGetUniformiv(copiedFrom, copy.from, ints); glUniform2iv(copy.to, 1, ints); break;
+      case GL_INT_VEC3:
+      case GL_BOOL_VEC3:    glGetUniformiv(copiedFrom, copy.from, ints); glUniform3iv(copy.to, 1, ints); break;
+      case GL_INT_VEC4:
+      case GL_BOOL_VEC4:    glGetUniformiv(copiedFrom, copy.from, ints); glUniform4iv(copy.to, 1, ints); break;
+      case GL_UNSIGNED_INT: glGetUniformuiv(copiedFrom, copy.from, uints); glUniform1uiv(copy.to, 1, uints); break;
+      default: break;
+      }
+    }
+  }
+
+  void InstanceBatcher::draw(const unsigned int sceneProgram) {
+    drawCalls = 0;
+    if (!glDrawElementsInstanced || !glVertexAttribDivisor) {
+      Logger::error("InstanceBatcher", "draw", "Instanced drawing requires OpenGL 3.3");
+      return;
+    }
+    if (program == 0) {
+      Logger::error("InstanceBatcher", "draw", "No instanced program set");
+      return;
+    }
+
+    // The scene program holds whatever camera, lights and material the
+    // renderer just drew with; batches draw under the same ones.
+    glUseProgram(program);
+    if (sceneProgram != 0) {
+      if (sceneProgram != copiedFrom || program != copiedTo) mapUniforms(sceneProgram);
+      copyUniforms();
+    }
+    if (textureLocation >= 0) glUniform1i(textureLocation, 0);
+
+    for (const auto& batch : batches) {
+      const size_t count = batch->transforms.size() / MATRIX_FLOATS;
+      if (count == 0 || batch->buffer == 0) continue;
+
+      // The instance attributes live on the mesh's own VAO, so they are
+      // bound around the draw and disabled again for the non-instanced path.
+      glBindVertexArray(batch->key.vertexArray);
+      glBindBuffer(GL_ARRAY_BUFFER, batch->buffer);
+      for (unsigned int column = 0; column < 4; ++column) {
+        const unsigned int location = attributeLocation + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(MATRIX_BYTES), reinterpret_cast<const void*>(column * 4 * sizeof(float)));
+        glVertexAttribDivisor(location, 1);
+      }
+
+      if (useTextureLocation >= 0) glUniform1i(useTextureLocation, batch->key.texture != 0 ? 1 : 0);
+      if (batch->key.texture != 0) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, batch->key.texture);
+      }
+      if (colourLocation >= 0) {
+        const std::uint32_t colour = batch->key.colour;
+        const float rgba[4] = { (colour >> 24) / 255.0f, ((colour >> 16) & 0xFF) / 255.0f, ((colour >> 8) & 0xFF) / 255.0f, (colour & 0xFF) / 255.0f };
+        if (colourType == GL_FLOAT_VEC4) glUniform4fv(colourLocation, 1, rgba);
+        else glUniform3fv(colourLocation, 1, rgba);
+      }
+      glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(batch->key.indexCount), batch->key.indexType, nullptr, static_cast<GLsizei>(count));
+      ++drawCalls;
+
+      for (unsigned int column = 0; column < 4; ++column) {
+        glVertexAttribDivisor(attributeLocation + column, 0);
+        glDisableVertexAttribArray(attributeLocation + column);
+      }
+    }
+    glBindVertexArray(0);
+    // The renderer expects its own program back for the next frame.
+    if (sceneProgram != 0) glUseProgram(sceneProgram);
+  }
+}
@@ -0,0 +1,130 @@
+#include "starlet-engine/job_system.hpp"
+
+namespace Starlet::Engine {
+  namespace {
+    struct ThreadSlot {
+      const JobSystem* owner{ nullptr };
+      unsigned int index{ 0 };
+    };
+    thread_local ThreadSlot currentSlot;
+  }
+
+  JobSystem::JobSystem(unsigned int workerCount) {
+    if (workerCount == HARDWARE) {
+      const unsigned int hardware = std::thread::hardware_concurrency();
+      workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    // Queue 0 belongs to outside threads; workers own queues 1..N.
+    for (unsigned int i = 0; i <= workerCount; ++i) queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(workerCount);
+    for (unsigned int i = 1; i <= workerCount; ++i)
+      workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+  JobSystem::~JobSystem() {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      stopping.store(true, std::memory_order_release);
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+  }
+
+  unsigned int JobSystem::getCurrentThreadIndex() const {
+    if (currentSlot.owner == this) return currentSlot.index;
+    return std::this_thread::get_id() == ownerThread.load(std::memory_order_relaxed) ? 0 : FOREIGN;
+  }
+
+  void JobSystem::submit(Job job, JobCounter* counter) {
+    if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Foreign threads share the owner's queue; it is locked like any other.
+    const unsigned int self = getCurrentThreadIndex();
+    Queue& queue = *queues[self == FOREIGN ? 0 : self];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.entries.push_back({ std::move(job), counter });
+    }
+    queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this wake-up after any worker's predicate
+    // check, so the notification cannot be lost.
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+  }
+
+  void JobSystem::wait(const JobCounter& counter) {
+    const unsigned int self = getCurrentThreadIndex();
+    if (self == FOREIGN) {
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      finished.wait(lock, [&counter] { return counter.isDone(); });
+      return;
+    }
+
+    while (!counter.isDone()) {
+      if (tryRunOne(self)) continue;
+
+      // Nothing left to help with: sleep until the counter completes or new work arrives.
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wake.wait(lock, [this, &counter] { return counter.isDone() || queued.load(std::memory_order_acquire) > 0; });
+    }
+  }
+
+  void JobSystem::complete(JobCounter& counter) {
+    if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // The counter may be destroyed as soon as a waiter sees it done, so it is
+    // not touched past this point. The lock orders the notification after
+    // any waiter's predicate check.
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_all();
+    finished.notify_all();
+  }
+
+  bool JobSystem::tryRunOne(const unsigned int self) {
+    if (self == FOREIGN) return false;
+
+    Entry entry;
+    bool found = false;
+
+    {
+      Queue& own = *queues[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.entries.empty()) {
+        entry = std::move(own.entries.back());
+        own.entries.pop_back();
+        found = true;
+      }
+    }
+
+    const size_t queueCount = queues.size();
+    for (size_t offset = 1; !found && offset < queueCount; ++offset) {
+      Queue& victim = *queues[(self + offset) % queueCount];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.entries.empty()) {
+        entry = std::move(victim.entries.front());
+        victim.entries.pop_front();
+        found = true;
+      }
+    }
+
+    if (!found) return false;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    entry.job();
+    if (entry.counter) complete(*entry.counter);
+    return true;
+  }
+
+  void JobSystem::workerLoop(const unsigned int index) {
+    currentSlot = { this, index };
+
+    while (!stopping.load(std::memory_order_acquire)) {
+      if (tryRunOne(index)) continue;
+
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wake.wait(lock, [this] { return stopping.load(std::memory_order_acquire) || queued.load(std::memory_order_acquire) > 0; });
+    }
+  }
+}
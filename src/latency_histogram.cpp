@@ -0,0 +1,47 @@
+#include "starlet-engine/latency_histogram.hpp"
+
+#include <cstdio>
+
+namespace Starlet::Engine {
+  void LatencyHistogram::record(const double milliseconds) {
+    size_t bucket = 0;
+    while (bucket < BUCKET_LIMITS_MS.size() && milliseconds > BUCKET_LIMITS_MS[bucket]) ++bucket;
+
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+
+    const std::uint64_t micros = milliseconds > 0.0 ? static_cast<std::uint64_t>(milliseconds * 1000.0) : 0;
+    std::uint64_t previous = maxMicros.load(std::memory_order_relaxed);
+    while (micros > previous && !maxMicros.compare_exchange_weak(previous, micros, std::memory_order_relaxed)) {}
+  }
+
+  void LatencyHistogram::clear() {
+    for (std::atomic<std::uint64_t>& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+  }
+
+  double LatencyHistogram::getPercentileUpperBound(const double percentile) const {
+    const std::uint64_t count = getCount();
+    if (count == 0) return 0.0;
+
+    const double target = percentile * static_cast<double>(count);
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_LIMITS_MS.size(); ++i) {
+      seen += getBucket(i);
+      if (static_cast<double>(seen) >= target) return BUCKET_LIMITS_MS[i];
+    }
+    return getMaxMilliseconds();
+  }
+
+  std::string LatencyHistogram::toString() const {
+    std::string out;
+    char entry[48];
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      if (i < BUCKET_LIMITS_MS.size()) std::snprintf(entry, sizeof(entry), "<=%.1fms:%llu ", BUCKET_LIMITS_MS[i], static_cast<unsigned long long>(getBucket(i)));
+      else std::snprintf(entry, sizeof(entry), ">%.1fms:%llu", BUCKET_LIMITS_MS.back(), static_cast<unsigned long long>(getBucket(i)));
+      out += entry;
+    }
+    return out;
+  }
+}
@@ -0,0 +1,31 @@
+#include "starlet-engine/load_stats.hpp"
+
+#include <cstdio>
+
+namespace Starlet::Engine {
+  void LoadStats::record(const std::string& name, const double seconds) {
+    for (LoadStage& stage : stages)
+      if (stage.name == name) {
+        stage.seconds += seconds;
+        return;
+      }
+    stages.push_back({ name, seconds });
+  }
+
+  double LoadStats::getTotalSeconds() const {
+    double total = 0.0;
+    for (const LoadStage& stage : stages) total += stage.seconds;
+    return total;
+  }
+
+  std::string LoadStats::toString() const {
+    std::string out;
+    char line[128];
+    for (const LoadStage& stage : stages) {
+      std::snprintf(line, sizeof(line), "%s=%.3fms ", stage.name.c_str(), stage.seconds * 1000.0);
+      out += line;
+    }
+    std::snprintf(line, sizeof(line), "total=%.3fms", getTotalSeconds() * 1000.0);
+    return out + line;
+  }
+}
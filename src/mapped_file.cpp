@@ -0,0 +1,106 @@
+#include "starlet-engine/mapped_file.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Starlet::Engine {
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+  MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+  }
+  MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) return *this;
+
+    close();
+    std::swap(view, other.view);
+    std::swap(length, other.length);
+#ifdef _WIN32
+    std::swap(fileHandle, other.fileHandle);
+    std::swap(mappingHandle, other.mappingHandle);
+#endif
+    return *this;
+  }
+
+#ifdef _WIN32
+  bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+      CloseHandle(file);
+      return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+      CloseHandle(file);
+      return Logger::error("MappedFile", "open", "Failed to map file: " + path);
+    }
+
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return Logger::error("MappedFile", "open", "Failed to map view of file: " + path);
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+  }
+
+  void MappedFile::close() {
+    if (view) UnmapViewOfFile(view);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    view = mappingHandle = fileHandle = nullptr;
+    length = 0;
+  }
+#else
+  bool MappedFile::open(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+      ::close(fd);
+      return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return Logger::error("MappedFile", "open", "Failed to map file: " + path);
+
+    view = mapped;
+    length = static_cast<size_t>(info.st_size);
+    return true;
+  }
+
+  void MappedFile::close() {
+    if (view) munmap(view, length);
+    view = nullptr;
+    length = 0;
+  }
+#endif
+}
@@ -0,0 +1,313 @@
+#include "starlet-engine/png_writer.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Starlet::Engine {
+  namespace {
+    // Slicing-by-8 tables: table[0] is the classic byte table, table[k]
+    // advances a byte that sits k positions further back in the word.
+    using CrcTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+    const CrcTables& crcTables() {
+      static const CrcTables tables = [] {
+        CrcTables built{};
+        for (std::uint32_t n = 0; n < 256; ++n) {
+          std::uint32_t c = n;
+          for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+          built[0][n] = c;
+        }
+        for (std::uint32_t n = 0; n < 256; ++n)
+          for (size_t k = 1; k < 8; ++k)
+            built[k][n] = built[0][built[k - 1][n] & 0xFF] ^ (built[k - 1][n] >> 8);
+        return built;
+      }();
+      return tables;
+    }
+
+    std::uint32_t updateCrc(std::uint32_t crc, const unsigned char* data, size_t size) {
+      const auto& t = crcTables();
+      for (; size >= 8; data += 8, size -= 8) {
+        const std::uint32_t low = crc ^ (std::uint32_t{ data[0] } | std::uint32_t{ data[1] } << 8 | std::uint32_t{ data[2] } << 16 | std::uint32_t{ data[3] } << 24);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+          ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+      }
+      for (; size > 0; ++data, --size) crc = t[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+      return crc;
+    }
+
+    void putBigEndian(unsigned char* out, const std::uint32_t value) {
+      out[0] = static_cast<unsigned char>(value >> 24);
+      out[1] = static_cast<unsigned char>(value >> 16);
+      out[2] = static_cast<unsigned char>(value >> 8);
+      out[3] = static_cast<unsigned char>(value);
+    }
+
+    // Writes a chunk's type and data while folding them into the running CRC.
+    class ChunkWriter {
+    public:
+      ChunkWriter(FILE* file, const char* type, const std::uint32_t length) : file(file) {
+        unsigned char header[8];
+        putBigEndian(header, length);
+        for (int i = 0; i < 4; ++i) header[4 + i] = static_cast<unsigned char>(type[i]);
+        std::fwrite(header, 8, 1, file);
+        crc = updateCrc(crc, header + 4, 4);
+      }
+
+      void write(const unsigned char* data, const size_t size) {
+        if (size == 0) return;
+        std::fwrite(data, size, 1, file);
+        crc = updateCrc(crc, data, size);
+      }
+
+      void finish() {
+        unsigned char footer[4];
+        putBigEndian(footer, crc ^ 0xFFFFFFFFu);
+        std::fwrite(footer, 4, 1, file);
+      }
+
+    private:
+      FILE* file;
+      std::uint32_t crc{ 0xFFFFFFFFu };
+    };
+
+    std::uint32_t updateAdler(const std::uint32_t adler, const unsigned char* data, const size_t size) {
+      // 5552 bytes is the most that can be summed before b could overflow.
+      std::uint32_t a = adler & 0xFFFF, b = adler >> 16;
+      for (size_t start = 0; start < size; start += 5552) {
+        const size_t stop = std::min(size, start + 5552);
+        for (size_t i = start; i < stop; ++i) {
+          a += data[i];
+          b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+      }
+      return (b << 16) | a;
+    }
+
+    // Appends LSB-first bit fields to a byte vector, as deflate packs them.
+    class BitWriter {
+    public:
+      explicit BitWriter(std::vector<unsigned char>& out) : out(out) {}
+
+      void put(const std::uint32_t value, const unsigned int count) {
+        bits |= std::uint64_t{ value } << used;
+        used += count;
+        while (used >= 8) {
+          out.push_back(static_cast<unsigned char>(bits));
+          bits >>= 8;
+          used -= 8;
+        }
+      }
+
+      void flush() {
+        if (used > 0) out.push_back(static_cast<unsigned char>(bits));
+        bits = 0;
+        used = 0;
+      }
+
+    private:
+      std::vector<unsigned char>& out;
+      std::uint64_t bits{ 0 };
+      unsigned int used{ 0 };
+    };
+
+    unsigned int highestBit(std::uint32_t value) {
+      unsigned int bit = 0;
+      while (value >>= 1) ++bit;
+      return bit;
+    }
+
+    std::uint32_t reverseBits(std::uint32_t code, const unsigned int length) {
+      std::uint32_t reversed = 0;
+      for (unsigned int i = 0; i < length; ++i, code >>= 1) reversed = (reversed << 1) | (code & 1);
+      return reversed;
+    }
+
+    // Fixed-Huffman literal/length codes (RFC 1951 3.2.6), already bit-reversed for BitWriter.
+    struct FixedCodes {
+      std::array<std::uint16_t, 288> code{};
+      std::array<std::uint8_t, 288> length{};
+    };
+
+    const FixedCodes& fixedCodes() {
+      static const FixedCodes codes = [] {
+        FixedCodes built;
+        for (std::uint32_t symbol = 0; symbol < 288; ++symbol) {
+          std::uint32_t code = 0;
+          unsigned int length = 0;
+          if (symbol < 144)      { code = 0x30 + symbol;          length = 8; }
+          else if (symbol < 256) { code = 0x190 + symbol - 144;   length = 9; }
+          else if (symbol < 280) { code = symbol - 256;           length = 7; }
+          else                   { code = 0xC0 + symbol - 280;    length = 8; }
+          built.code[symbol] = static_cast<std::uint16_t>(reverseBits(code, length));
+          built.length[symbol] = static_cast<std::uint8_t>(length);
+        }
+        return built;
+      }();
+      return codes;
+    }
+
+    void putLiteral(BitWriter& out, const FixedCodes& codes, const unsigned int symbol) {
+      out.put(codes.code[symbol], codes.length[symbol]);
+    }
+
+    void putMatch(BitWriter& out, const FixedCodes& codes, const unsigned int length, const unsigned int distance) {
+      // Length 3..258 as symbols 257..285; 258 has its own symbol.
+      if (length == 258) putLiteral(out, codes, 285);
+      else {
+        const std::uint32_t x = length - 3;
+        if (x < 8) putLiteral(out, codes, 257 + x);
+        else {
+          const unsigned int msb = highestBit(x);
+          putLiteral(out, codes, 257 + 4 * (msb - 1) + ((x >> (msb - 2)) & 3));
+          out.put(x & ((1u << (msb - 2)) - 1), msb - 2);
+        }
+      }
+
+      // Distance 1..32768 as codes 0..29, each five bits.
+      const std::uint32_t y = distance - 1;
+      if (y < 4) out.put(reverseBits(y, 5), 5);
+      else {
+        const unsigned int msb = highestBit(y);
+        out.put(reverseBits(2 * msb + ((y >> (msb - 1)) & 1), 5), 5);
+        out.put(y & ((1u << (msb - 1)) - 1), msb - 1);
+      }
+    }
+
+    // Single-probe LZ77 into one fixed-Huffman block: much smaller than
+    // stored blocks on rendered frames, at a few ns per byte.
+    void deflateFast(const std::vector<unsigned char>& in, std::vector<unsigned char>& out) {
+      constexpr size_t WINDOW = 32768;
+      constexpr size_t MIN_MATCH = 4;
+      constexpr size_t MAX_MATCH = 258;
+      constexpr unsigned int HASH_BITS = 15;
+
+      thread_local std::vector<std::uint32_t> table;
+      table.assign(size_t{ 1 } << HASH_BITS, 0);
+      const auto hash = [&in](const size_t at) {
+        std::uint32_t word;
+        std::memcpy(&word, &in[at], 4);
+        return (word * 2654435761u) >> (32 - HASH_BITS);
+      };
+
+      const FixedCodes& codes = fixedCodes();
+      BitWriter bits(out);
+      bits.put(0x3, 3); // BFINAL, fixed Huffman
+
+      const size_t size = in.size();
+      size_t at = 0;
+      while (at + MIN_MATCH <= size) {
+        // Positions are stored plus one, so zero means empty.
+        std::uint32_t& slot = table[hash(at)];
+        const size_t candidate = slot;
+        slot = static_cast<std::uint32_t>(at + 1);
+
+        if (candidate != 0 && at - (candidate - 1) <= WINDOW && std::memcmp(&in[candidate - 1], &in[at], MIN_MATCH) == 0) {
+          const size_t from = candidate - 1;
+          const size_t limit = std::min(MAX_MATCH, size - at);
+          size_t length = MIN_MATCH;
+          while (length < limit && in[from + length] == in[at + length]) ++length;
+
+          putMatch(bits, codes, static_cast<unsigned int>(length), static_cast<unsigned int>(at - from));
+          at += length;
+          if (at + MIN_MATCH <= size) table[hash(at - 1)] = static_cast<std::uint32_t>(at);
+          continue;
+        }
+
+        putLiteral(bits, codes, in[at]);
+        ++at;
+      }
+      for (; at < size; ++at) putLiteral(bits, codes, in[at]);
+
+      putLiteral(bits, codes, 256);
+      bits.flush();
+    }
+  }
+
+  bool writePng(const std::string& path, const unsigned int width, const unsigned int height, const unsigned char* rgba, const bool bottomUp, const PngCompression compression) {
+    if (width == 0 || height == 0 || !rgba) return Logger::error("PngWriter", "writePng", "Empty image: " + path);
+
+    const size_t rowBytes = size_t{ width } * 4;
+    const size_t rawSize = (rowBytes + 1) * height;
+    constexpr size_t MAX_BLOCK = 65535;
+    const size_t blockCount = (rawSize + MAX_BLOCK - 1) / MAX_BLOCK;
+    const size_t storedSize = 2 + blockCount * 5 + rawSize + 4;
+    if (storedSize > 0x7FFFFFFFu) return Logger::error("PngWriter", "writePng", "Image too large: " + path);
+
+    // Scanlines carry the Up filter (each byte minus the one above it), which
+    // turns the flat and vertically smooth regions of rendered frames into
+    // zero runs. The buffers are per thread so capture workers reuse them.
+    thread_local std::vector<unsigned char> scanlines;
+    thread_local std::vector<unsigned char> compressed;
+    scanlines.resize(rawSize);
+    for (unsigned int y = 0; y < height; ++y) {
+      const unsigned char* row = rgba + size_t{ bottomUp ? height - 1 - y : y } * rowBytes;
+      const unsigned char* above = y == 0 ? nullptr : rgba + size_t{ bottomUp ? height - y : y - 1 } * rowBytes;
+      unsigned char* line = &scanlines[size_t{ y } * (rowBytes + 1)];
+      line[0] = 2;
+      if (above) for (size_t i = 0; i < rowBytes; ++i) line[1 + i] = static_cast<unsigned char>(row[i] - above[i]);
+      else std::memcpy(line + 1, row, rowBytes);
+    }
+
+    compressed.clear();
+    if (compression == PngCompression::Fast) deflateFast(scanlines, compressed);
+    // Noise can make fixed codes larger than the input; stored blocks cap the size.
+    const bool stored = compression == PngCompression::Stored || compressed.size() + 6 >= storedSize;
+    const size_t idatSize = stored ? storedSize : 2 + compressed.size() + 4;
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return Logger::error("PngWriter", "writePng", "Failed to open for writing: " + path);
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+
+    static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::fwrite(SIGNATURE, 8, 1, file);
+
+    unsigned char ihdr[13] = {};
+    putBigEndian(ihdr, width);
+    putBigEndian(ihdr + 4, height);
+    ihdr[8] = 8;  // bit depth
+    ihdr[9] = 6;  // RGBA
+    ChunkWriter header(file, "IHDR", 13);
+    header.write(ihdr, 13);
+    header.finish();
+
+    ChunkWriter idat(file, "IDAT", static_cast<std::uint32_t>(idatSize));
+    const unsigned char zlibHeader[2] = { 0x78, 0x01 };
+    idat.write(zlibHeader, 2);
+
+    if (stored) {
+      // Split into stored blocks of at most 64 KiB.
+      for (size_t written = 0; written < rawSize; written += MAX_BLOCK) {
+        const size_t take = std::min(MAX_BLOCK, rawSize - written);
+        const bool last = written + take == rawSize;
+        const std::uint16_t length = static_cast<std::uint16_t>(take);
+        const unsigned char block[5] = { static_cast<unsigned char>(last ? 1 : 0),
+          static_cast<unsigned char>(length & 0xFF), static_cast<unsigned char>(length >> 8),
+          static_cast<unsigned char>(~length & 0xFF), static_cast<unsigned char>((~length >> 8) & 0xFF) };
+        idat.write(block, 5);
+        idat.write(scanlines.data() + written, take);
+      }
+    }
+    else idat.write(compressed.data(), compressed.size());
+
+    unsigned char adler[4];
+    putBigEndian(adler, updateAdler(1, scanlines.data(), scanlines.size()));
+    idat.write(adler, 4);
+    idat.finish();
+
+    ChunkWriter end(file, "IEND", 0);
+    end.finish();
+
+    const bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    if (!ok) return Logger::error("PngWriter", "writePng", "Failed to write: " + path);
+    return true;
+  }
+}
@@ -0,0 +1,110 @@
+#include "starlet-engine/profiler.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace Starlet::Engine {
+  void ProfileBuffer::push(const char* name, const Clock::Ticks start, const Clock::Ticks end) {
+    const std::uint64_t written = head.load(std::memory_order_relaxed);
+    if (written - tail.load(std::memory_order_acquire) >= CAPACITY) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    events[written & (CAPACITY - 1)] = { name, start, end, threadId };
+    head.store(written + 1, std::memory_order_release);
+  }
+
+  Profiler& Profiler::get() {
+    static Profiler instance;
+    return instance;
+  }
+
+  ProfileBuffer& Profiler::threadBuffer() {
+    // Buffers are owned by the profiler and never freed, so a thread exiting
+    // mid-capture leaves its events readable.
+    thread_local ProfileBuffer* buffer = nullptr;
+    if (!buffer) {
+      std::lock_guard<std::mutex> lock(registryMutex);
+      buffers.push_back(std::make_unique<ProfileBuffer>(static_cast<std::uint32_t>(buffers.size())));
+      buffer = buffers.back().get();
+    }
+    return *buffer;
+  }
+
+  void Profiler::record(const char* name, const Clock::Ticks start, const Clock::Ticks end) {
+    threadBuffer().push(name, start, end);
+  }
+
+  const char* Profiler::intern(const std::string& name) {
+    std::string clean = name;
+    std::replace_if(clean.begin(), clean.end(), [](const char c) { return c == '"' || c == '\\'; }, '_');
+
+    // Set nodes never move, so the pointer stays valid as more names arrive.
+    std::lock_guard<std::mutex> lock(namesMutex);
+    return names.insert(std::move(clean)).first->c_str();
+  }
+
+  void Profiler::collect() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ProfileBuffer>& buffer : buffers) {
+      if (capturing) buffer->drain([this](const ProfileEvent& event) { captured.push_back(event); });
+      else buffer->drain([](const ProfileEvent&) {});
+    }
+  }
+
+  void Profiler::endFrame() {
+    const Clock::Ticks now = Clock::now();
+    if (lastFrameEnd != 0) {
+      frameStats.record(Clock::toMilliseconds(now - lastFrameEnd));
+      if (capturing) captured.push_back({ "Frame", lastFrameEnd, now, threadBuffer().getThreadId() });
+    }
+    lastFrameEnd = now;
+
+    collect();
+  }
+
+  void Profiler::beginCapture() {
+    collect();
+    captured.clear();
+    capturing = true;
+    Logger::debug("Profiler", "beginCapture", "Trace capture started");
+  }
+
+  bool Profiler::endCapture(const std::string& path) {
+    if (!capturing) return Logger::error("Profiler", "endCapture", "No capture in progress");
+
+    collect();
+    capturing = false;
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return Logger::error("Profiler", "endCapture", "Failed to open trace file: " + path);
+
+    // chrome://tracing / Perfetto "complete" events, timestamps in microseconds.
+    Clock::Ticks origin = captured.empty() ? 0 : captured.front().start;
+    for (const ProfileEvent& event : captured) origin = std::min(origin, event.start);
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    for (size_t i = 0; i < captured.size(); ++i) {
+      const ProfileEvent& event = captured[i];
+      std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+        i == 0 ? "" : ",\n", event.name, event.threadId,
+        Clock::toMicroseconds(event.start - origin), Clock::toMicroseconds(event.end - event.start));
+    }
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+
+    std::uint64_t dropped = 0;
+    {
+      std::lock_guard<std::mutex> lock(registryMutex);
+      for (const std::unique_ptr<ProfileBuffer>& buffer : buffers) dropped += buffer->getDropped();
+    }
+
+    const size_t eventCount = captured.size();
+    captured.clear();
+    captured.shrink_to_fit();
+    return Logger::debug("Profiler", "endCapture", "Wrote " + std::to_string(eventCount) + " events to " + path
+      + (dropped > 0 ? " (" + std::to_string(dropped) + " dropped)" : ""));
+  }
+}
@@ -0,0 +1,137 @@
+#include "starlet-engine/program_cache.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include "starlet-engine/content_hash.hpp"
+#include "starlet-engine/mapped_file.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace Starlet::Engine {
+  ProgramCache::~ProgramCache() {
+    // Programs die with their context; only delete them while it is still current.
+    if (programs.empty() || !glfwGetCurrentContext()) return;
+    for (const auto& [name, program] : programs) glDeleteProgram(program);
+  }
+
+  void ProgramCache::registerProgram(const std::string& name, const unsigned int program) {
+    unsigned int& slot = programs[name];
+    if (slot != 0 && slot != program) glDeleteProgram(slot);
+    slot = program;
+  }
+
+  unsigned int ProgramCache::getProgram(const std::string& name) const {
+    const auto it = programs.find(name);
+    return it != programs.end() ? it->second : 0;
+  }
+
+  unsigned int ProgramCache::build(const std::string& name, const std::vector<std::string>& sourcePaths, const Compile& compile, bool& fromCache) {
+    fromCache = false;
+    if (const unsigned int cached = load(name, sourcePaths)) {
+      fromCache = true;
+      return cached;
+    }
+
+    const unsigned int program = compile();
+    if (program != 0) store(name, program, sourcePaths);
+    return program;
+  }
+
+  bool ProgramCache::isSupported() const {
+    if (!glGetProgramBinary || !glProgramBinary) return false;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+  }
+
+  std::string ProgramCache::cachePathFor(const std::string& name) const {
+    return directory + "/" + name + ".pbin";
+  }
+
+  bool ProgramCache::computeKey(const std::vector<std::string>& sourcePaths, std::uint64_t& key) const {
+    key = hashString(driverId);
+    for (const std::string& path : sourcePaths) {
+      std::uint64_t sourceHash = 0;
+      if (!hashFile(path, sourceHash)) return false;
+      key = hashBytes(&sourceHash, sizeof(sourceHash), key);
+    }
+    return true;
+  }
+
+  unsigned int ProgramCache::load(const std::string& name, const std::vector<std::string>& sourcePaths) {
+    if (directory.empty() || !isSupported()) return 0;
+
+    std::uint64_t key = 0;
+    MappedFile file;
+    if (!computeKey(sourcePaths, key) || !file.open(cachePathFor(name))) return 0;
+    if (file.size() < sizeof(Header)) return 0;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (header.magic != MAGIC || header.formatVersion != FORMAT_VERSION || header.key != key
+      || header.payloadSize != file.size() - sizeof(Header)) return 0;
+
+    const GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, file.data() + sizeof(Header), static_cast<GLsizei>(header.payloadSize));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+      // Usually a driver update that kept the version string; recompile and rewrite.
+      glDeleteProgram(program);
+      file.close();
+      std::remove(cachePathFor(name).c_str());
+      Logger::debug("ProgramCache", "load", "Driver rejected cached binary for " + name);
+      return 0;
+    }
+
+    return program;
+  }
+
+  bool ProgramCache::store(const std::string& name, const unsigned int program, const std::vector<std::string>& sourcePaths) const {
+    if (directory.empty() || program == 0 || !isSupported()) return false;
+
+    Header header{ MAGIC, FORMAT_VERSION, 0, 0, 0, 0 };
+    if (!computeKey(sourcePaths, header.key))
+      return Logger::error("ProgramCache", "store", "Failed to hash shader sources for " + name);
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return Logger::error("ProgramCache", "store", "Driver returned no binary for " + name);
+
+    std::vector<unsigned char> payload(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, payload.data());
+    if (written <= 0) return Logger::error("ProgramCache", "store", "Failed to read program binary for " + name);
+    header.binaryFormat = format;
+    header.payloadSize = static_cast<std::uint64_t>(written);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    // Write to a temporary file and rename so a reader never maps a partial binary.
+    const std::string cachePath = cachePathFor(name);
+    const std::string tempPath = cachePath + ".tmp";
+
+    FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) return Logger::error("ProgramCache", "store", "Failed to open cache for writing: " + tempPath);
+
+    const bool ok = std::fwrite(&header, sizeof(Header), 1, out) == 1
+      && std::fwrite(payload.data(), header.payloadSize, 1, out) == 1;
+    std::fclose(out);
+
+    std::remove(cachePath.c_str());
+    if (!ok || std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+      std::remove(tempPath.c_str());
+      return Logger::error("ProgramCache", "store", "Failed to write cache: " + cachePath);
+    }
+
+    return Logger::debug("ProgramCache", "store", "Cached " + name + " (" + std::to_string(header.payloadSize) + " bytes)");
+  }
+}
@@ -0,0 +1,138 @@
+#include "starlet-engine/render_thread.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include <GLFW/glfw3.h>
+
+namespace Starlet::Engine {
+  bool RenderThread::start(GLFWwindow* windowIn, Callback renderIn, PresentCallback presentIn) {
+    if (isRunning()) return true;
+    if (!windowIn) return Logger::error("RenderThread", "start", "No window to render to");
+
+    window = windowIn;
+    render = std::move(renderIn);
+    present = std::move(presentIn);
+    stopping = false;
+    frameQueued = false;
+    sceneReleased = true;
+    presenting = false;
+
+    // A context can only be current on one thread at a time.
+    glfwMakeContextCurrent(nullptr);
+    thread = std::thread(&RenderThread::threadLoop, this);
+    return Logger::debug("RenderThread", "start", "Pipelined rendering started");
+  }
+
+  void RenderThread::stop() {
+    if (!isRunning()) return;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    signal.notify_all();
+    thread.join();
+
+    glfwMakeContextCurrent(window);
+    Logger::debug("RenderThread", "stop", "Pipelined rendering stopped");
+  }
+
+  FrameStats RenderThread::getLatency() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return latency;
+  }
+
+  void RenderThread::enqueue(Callback command) {
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back(std::move(command));
+  }
+
+  bool RenderThread::call(Call command) {
+    std::unique_lock<std::mutex> lock(mutex);
+    pendingCall = std::move(command);
+    callDone = false;
+    signal.notify_all();
+
+    signal.wait(lock, [this] { return callDone; });
+    return callResult;
+  }
+
+  void RenderThread::runCommands() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      executing.swap(commands);
+    }
+    for (Callback& command : executing) command();
+    executing.clear();
+  }
+
+  void RenderThread::submitFrame(const Clock::Ticks inputTimestamp) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Wait for the previous present so no more than one frame is in flight.
+    signal.wait(lock, [this] { return !frameQueued && !presenting; });
+
+    frameQueued = true;
+    sceneReleased = false;
+    submittedAt = Clock::now();
+    submittedInput = inputTimestamp;
+    signal.notify_all();
+
+    signal.wait(lock, [this] { return sceneReleased; });
+  }
+
+  void RenderThread::threadLoop() {
+    glfwMakeContextCurrent(window);
+
+    for (;;) {
+      Clock::Ticks frameSubmittedAt = 0;
+      Clock::Ticks frameInput = 0;
+      Call command;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [this] { return stopping || frameQueued || pendingCall; });
+        if (pendingCall) command = std::move(pendingCall);
+        else if (!frameQueued) break;
+
+        pendingCall = nullptr;
+        frameSubmittedAt = submittedAt;
+        frameInput = submittedInput;
+      }
+
+      if (command) {
+        // The caller is blocked in call(), so no frame can be queued meanwhile.
+        runCommands();
+        const bool result = command();
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          callResult = result;
+          callDone = true;
+        }
+        signal.notify_all();
+        continue;
+      }
+
+      runCommands();
+
+      render();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        frameQueued = false;
+        sceneReleased = true;
+        presenting = true;
+      }
+      signal.notify_all();
+
+      present(frameInput);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        presenting = false;
+        latency.record(Clock::toMilliseconds(Clock::now() - frameSubmittedAt));
+      }
+      signal.notify_all();
+    }
+
+    // Apply commands queued after the last frame before handing the context back.
+    runCommands();
+    glfwMakeContextCurrent(nullptr);
+  }
+}
@@ -0,0 +1,81 @@
+#include "starlet-engine/resource_registry.hpp"
+#include "starlet-logger/logger.hpp"
+
+#include "starlet-engine/content_hash.hpp"
+
+namespace Starlet::Engine {
+  ResourceRegistry::~ResourceRegistry() {
+    size_t referenced = 0;
+    for (const auto& [key, entry] : entries)
+      if (entry->references > 0) ++referenced;
+    if (referenced > 0)
+      Logger::error("ResourceRegistry", "~ResourceRegistry", std::to_string(referenced) + " resource(s) still referenced at shutdown");
+  }
+
+  ResourceKey ResourceRegistry::keyForFile(const std::string& path, const std::string& type) {
+    std::uint64_t contentHash = 0;
+    if (!hashFile(path, contentHash)) return 0;
+    return hashBytes(&contentHash, sizeof(contentHash), hashString(type));
+  }
+
+  ResourceRegistry::Handle ResourceRegistry::acquire(const ResourceKey key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    return it != entries.end() ? Handle(it->second.get(), key) : Handle();
+  }
+
+  ResourceRegistry::Handle ResourceRegistry::insert(const ResourceKey key, Release release, const size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    if (it != entries.end()) {
+      if (release) release();
+      return Handle(it->second.get(), key);
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->release = std::move(release);
+    entry->bytes = bytes;
+    residentBytes += bytes;
+
+    Entry* raw = entry.get();
+    entries.emplace(key, std::move(entry));
+    return Handle(raw, key);
+  }
+
+  bool ResourceRegistry::isResident(const ResourceKey key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.count(key) > 0;
+  }
+
+  size_t ResourceRegistry::collect() {
+    std::vector<std::unique_ptr<Entry>> evicted;
+    {
+      // acquire() only hands out handles under the lock, so a zero count seen
+      // here cannot be raised again before the entry is unlinked.
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second->references > 0) {
+          ++it;
+          continue;
+        }
+        residentBytes -= it->second->bytes;
+        evicted.push_back(std::move(it->second));
+        it = entries.erase(it);
+      }
+    }
+
+    for (const auto& entry : evicted)
+      if (entry->release) entry->release();
+    return evicted.size();
+  }
+
+  size_t ResourceRegistry::getResidentCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  size_t ResourceRegistry::getResidentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentBytes;
+  }
+}
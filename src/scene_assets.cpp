@@ -0,0 +1,56 @@
+#include "starlet-engine/scene_assets.hpp"
+
+#include "starlet-engine/mapped_file.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace Starlet::Engine {
+  static constexpr size_t PAGE_SIZE{ 4096 };
+
+  void AssetIndex::build(const std::string& root, const std::vector<std::string>& excluded) {
+    files.clear();
+    std::error_code ec;
+    const fs::path base(root);
+    for (fs::recursive_directory_iterator it(base, ec), end; !ec && it != end; it.increment(ec)) {
+      const fs::path relative = it->path().lexically_relative(base);
+      if (it->is_directory(ec)) {
+        const std::string dir = relative.generic_string();
+        if (std::find(excluded.begin(), excluded.end(), dir) != excluded.end()) it.disable_recursion_pending();
+        continue;
+      }
+      if (!it->is_regular_file(ec)) continue;
+
+      const std::string path = it->path().generic_string();
+      files.emplace(relative.generic_string(), path);
+      files.emplace(relative.filename().generic_string(), path);
+    }
+  }
+
+  bool AssetIndex::contains(const std::string& name) const {
+    return files.find(fs::path(name).lexically_normal().generic_string()) != files.end();
+  }
+
+  std::vector<std::string> AssetIndex::resolve(const std::vector<std::string>& names) const {
+    std::vector<std::string> found;
+    std::unordered_set<std::string> seen;
+    for (const std::string& name : names) {
+      const auto match = files.find(fs::path(name).lexically_normal().generic_string());
+      if (match != files.end() && seen.insert(match->second).second) found.push_back(match->second);
+    }
+    return found;
+  }
+
+  bool prefetchFile(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+
+    // Touching one byte per page is enough to fault the file in.
+    volatile unsigned char sink = 0;
+    for (size_t offset = 0; offset < file.size(); offset += PAGE_SIZE) sink = sink + file.data()[offset];
+    return true;
+  }
+}
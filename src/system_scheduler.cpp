@@ -0,0 +1,79 @@
+#include "starlet-engine/system_scheduler.hpp"
+
+#include "starlet-engine/job_system.hpp"
+#include "starlet-engine/frame_context.hpp"
+#include "starlet-engine/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Starlet::Engine {
+  namespace {
+    bool overlaps(const std::vector<std::type_index>& a, const std::vector<std::type_index>& b) {
+      for (const std::type_index& type : a)
+        if (std::find(b.begin(), b.end(), type) != b.end()) return true;
+      return false;
+    }
+  }
+
+  bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+    return overlaps(writes, other.writes) || overlaps(writes, other.reads) || overlaps(reads, other.writes);
+  }
+
+  void SystemScheduler::add(const std::string& name, SystemAccess access, Update update) {
+    systems.push_back({ name, Profiler::get().intern(name), std::move(access), std::move(update) });
+    phasesDirty = true;
+  }
+
+  void SystemScheduler::clear() {
+    systems.clear();
+    phases.clear();
+    phasesDirty = false;
+  }
+
+  void SystemScheduler::buildPhases() {
+    if (!phasesDirty) return;
+
+    phases.clear();
+    std::vector<size_t> phaseOf(systems.size(), 0);
+    for (size_t i = 0; i < systems.size(); ++i) {
+      size_t phase = 0;
+      for (size_t j = 0; j < i; ++j)
+        if (systems[i].access.conflictsWith(systems[j].access)) phase = std::max(phase, phaseOf[j] + 1);
+
+      phaseOf[i] = phase;
+      if (phases.size() <= phase) phases.resize(phase + 1);
+      phases[phase].push_back(i);
+    }
+    phasesDirty = false;
+  }
+
+  bool SystemScheduler::run(JobSystem& jobs, const FrameContext& frame) {
+    buildPhases();
+
+    std::atomic<bool> changed{ false };
+    for (const std::vector<size_t>& phase : phases) {
+      Entry& first = systems[phase.front()];
+      if (phase.size() == 1) {
+        STARLET_PROFILE_ZONE(first.zoneName);
+        if (first.update(frame)) changed = true;
+        continue;
+      }
+
+      JobCounter counter;
+      for (size_t i = 1; i < phase.size(); ++i) {
+        Entry& entry = systems[phase[i]];
+        jobs.submit([&entry, &frame, &changed] {
+          STARLET_PROFILE_ZONE(entry.zoneName);
+          if (entry.update(frame)) changed = true;
+        }, &counter);
+      }
+      {
+        STARLET_PROFILE_ZONE(first.zoneName);
+        if (first.update(frame)) changed = true;
+      }
+      jobs.wait(counter);
+    }
+    return changed;
+  }
+}
@@ -0,0 +1,58 @@
+#include "starlet-engine/thread_pool.hpp"
+
+namespace Starlet::Engine {
+  ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+      const unsigned int hardware = std::thread::hardware_concurrency();
+      threadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+      workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    taskReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+  }
+
+  void ThreadPool::submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+  }
+
+  void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return tasks.empty() && active == 0; });
+  }
+
+  void ThreadPool::workerLoop() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (stopping && tasks.empty()) return;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        ++active;
+      }
+
+      task();
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        --active;
+        if (tasks.empty() && active == 0) idle.notify_all();
+      }
+    }
+  }
+}
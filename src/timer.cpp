@@ -1,26 +1,21 @@
 #include "starlet-engine/timer.hpp"
-#include "starlet-logger/logger.hpp"
-
-#include "GLFW/glfw3.h"
 
 namespace Starlet::Engine {
-	Timer::Timer() : lastTime(0.0f) {}
-
 	float Timer::tick() {
-		const float currentTime = static_cast<float>(glfwGetTime());
+		// Deltas are taken between integer nanosecond ticks and only narrowed
+		// to float at the end, so precision does not degrade with uptime. Long
+		// hitches are passed through unclamped; the fixed-step accumulator caps
+		// them, and the variable-step path clamps where it integrates.
+		const Clock::Ticks currentTicks = Clock::now();
 
-		if (lastTime == 0.0f) {
-			lastTime = currentTime;
+		if (lastTicks == 0) {
+			startTicks = currentTicks;
+			lastTicks = currentTicks;
 			return 0.0f;
 		}
 
-		const float rawDelta = currentTime - lastTime;
-		constexpr float maxDelta = 0.1f;
-
-		lastTime = currentTime;
-		float deltaTime = (rawDelta > maxDelta) ? maxDelta : rawDelta;
-
-		if (rawDelta > maxDelta) Logger::debug("Engine", "Tick", "deltaTime clamped to " + std::to_string(maxDelta) + " (was " + std::to_string(rawDelta) + ")");
-		return deltaTime;
+		const double deltaTime = Clock::toSeconds(currentTicks - lastTicks);
+		lastTicks = currentTicks;
+		return static_cast<float>(deltaTime);
 	}
-}
\ No newline at end of file
+}
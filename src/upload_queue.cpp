@@ -0,0 +1,36 @@
+#include "starlet-engine/upload_queue.hpp"
+
+namespace Starlet::Engine {
+  void UploadQueue::push(Upload upload) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      notFull.wait(lock, [this] { return uploads.size() < capacity; });
+      uploads.push_back(std::move(upload));
+    }
+    notEmpty.notify_one();
+  }
+
+  bool UploadQueue::tryPop(Upload& out) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (uploads.empty()) return false;
+
+      out = std::move(uploads.front());
+      uploads.pop_front();
+    }
+    notFull.notify_one();
+    return true;
+  }
+
+  bool UploadQueue::waitPop(Upload& out) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      notEmpty.wait(lock, [this] { return !uploads.empty(); });
+
+      out = std::move(uploads.front());
+      uploads.pop_front();
+    }
+    notFull.notify_one();
+    return true;
+  }
+}
@@ -14,13 +14,13 @@ namespace Starlet::Engine {
 		}
 	}
 
-	bool Window::createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title) {
+	bool Window::createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title, const bool withContext) {
 		window = glfwCreateWindow(widthIn, heightIn, title, nullptr, nullptr);
 		if (!window) return Logger::error("Window", "createWindow", "Failed to create GLFW window");
 
-		width = widthIn;
-		height = heightIn;
-		return Logger::debug("Window", "createWindow", "Created window: " + std::string(title) + " - " + std::to_string(width) + " x " + std::to_string(height));
+		contextCreated = withContext;
+		size.store(packSize(widthIn, heightIn), std::memory_order_relaxed);
+		return Logger::debug("Window", "createWindow", "Created window: " + std::string(title) + " - " + std::to_string(widthIn) + " x " + std::to_string(heightIn));
 	}
 	bool Window::shouldClose() const {
 		return window ? glfwWindowShouldClose(window) : true;
@@ -29,8 +29,16 @@ namespace Starlet::Engine {
 	void Window::pollEvents() const {
 		if (window) glfwPollEvents();
 	}
+	void Window::waitEvents(const double timeoutSeconds) const {
+		if (!window) return;
+		if (timeoutSeconds < 0.0) glfwWaitEvents();
+		else glfwWaitEventsTimeout(timeoutSeconds);
+	}
+	void Window::postEmptyEvent() const {
+		if (window) glfwPostEmptyEvent();
+	}
 	void Window::swapBuffers() const {
-		if (window) glfwSwapBuffers(window);
+		if (hasContext()) glfwSwapBuffers(window);
 	}
 	void Window::requestClose() const {
 		if (window) glfwSetWindowShouldClose(window, GLFW_TRUE);
@@ -41,17 +49,22 @@ namespace Starlet::Engine {
 		else if (window) glfwSetWindowUserPointer(window, userPointer);
 	}
 	void Window::setCurrentWindow() const {
-		if (window) glfwMakeContextCurrent(window);
+		if (hasContext()) glfwMakeContextCurrent(window);
 	}
 
 	void Window::updateViewport(const unsigned int widthIn, const unsigned int heightIn) {
 		if (window) {
-			width = widthIn;
-			height = heightIn;
-			glViewport(0, 0, width, height);
+			size.store(packSize(widthIn, heightIn), std::memory_order_relaxed);
+			if (contextCreated) glViewport(0, 0, widthIn, heightIn);
 		}
 	}
 
+	float Window::getAspect() const {
+		const unsigned long long packed = size.load(std::memory_order_relaxed);
+		const unsigned int height = unpackHeight(packed);
+		return height > 0 ? static_cast<float>(unpackWidth(packed)) / static_cast<float>(height) : 1.0f;
+	}
+
 	bool Window::switchActiveWindowVisibility() {
 		if (!window) return Logger::error("Window", "switchActiveWindowVisibility", "No active window to switch visibility.");
 
@@ -2,53 +2,132 @@
 #include "starlet-logger/logger.hpp"
 
 #include "starlet-engine/callbacks.hpp"
+#include "starlet-engine/profiler.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <thread>
 
 namespace Starlet::Engine {
   static constexpr int GL_MAJOR{ 3 };
   static constexpr int GL_MINOR{ 3 };
 
-  WindowManager::WindowManager() {
-    if (!glfwInit()) Logger::error("WindowManager", "Constructor", "Failed to initialize GLFW\n");
-  }
+  WindowManager::WindowManager() {}
   WindowManager::~WindowManager() {
-    glfwTerminate();
+    activeWindow.reset();
+    if (glfwReady) glfwTerminate();
+  }
+
+  bool WindowManager::initGLFW() {
+    if (glfwReady) return true;
+
+    // The platform hint must be set before glfwInit, so initialization waits
+    // until the backend is known.
+    glfwInitHint(GLFW_PLATFORM, backend == WindowBackend::Display ? GLFW_ANY_PLATFORM : GLFW_PLATFORM_NULL);
+    if (!glfwInit()) return Logger::error("WindowManager", "initGLFW", "Failed to initialize GLFW");
+
+    glfwReady = true;
+    return true;
+  }
+
+  bool WindowManager::createContextWindow(const unsigned int width, const unsigned int height, const char* title, const bool withContext) {
+    glfwWindowHint(GLFW_CLIENT_API, withContext ? GLFW_OPENGL_API : GLFW_NO_API);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, backend == WindowBackend::Offscreen ? GLFW_OSMESA_CONTEXT_API : GLFW_NATIVE_CONTEXT_API);
+
+    activeWindow = std::make_unique<Window>();
+    if (!activeWindow->createWindow(width, height, title, withContext)) {
+      activeWindow.reset();
+      return false;
+    }
+    return true;
   }
 
   bool WindowManager::createWindow(const unsigned int width, const unsigned int height, const char* title) {
-    Logger::debug("WindowManager", "createWindow", "Start time : " + std::to_string(glfwGetTime()));
+    STARLET_PROFILE_ZONE("WindowManager::createWindow");
+
+    if (!initGLFW()) return false;
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, GL_MAJOR);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, GL_MINOR);
     glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-    activeWindow = std::make_unique<Window>();
-    if (!activeWindow->createWindow(width, height, title)) {
-      activeWindow.reset();
-      return Logger::error("WindowManager", "createWindow", "Window creation failed");
+    if (!createContextWindow(width, height, title, backend != WindowBackend::Null)) {
+      if (backend != WindowBackend::Offscreen)
+        return Logger::error("WindowManager", "createWindow", "Window creation failed");
+
+      Logger::error("WindowManager", "createWindow", "OSMesa context unavailable, falling back to Null backend");
+      backend = WindowBackend::Null;
+      if (!createContextWindow(width, height, title, false))
+        return Logger::error("WindowManager", "createWindow", "Window creation failed");
     }
 
-    activeWindow->setCurrentWindow();
+    if (activeWindow->hasContext()) {
+      activeWindow->setCurrentWindow();
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-      return Logger::error("WindowManager", "createWindow", "Failed to initialize GLAD");
+      if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        return Logger::error("WindowManager", "createWindow", "Failed to initialize GLAD");
+    }
 
     GLFWwindow* window = activeWindow->getGLFWwindow();
     glfwSetKeyCallback(window, key_callback);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetScrollCallback(window, scroll_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+    glfwSetWindowFocusCallback(window, window_focus_callback);
+    glfwSetWindowIconifyCallback(window, window_iconify_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
 
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    glfwSwapInterval(1);
+    if (!activeWindow->hasContext())
+      return Logger::debug("WindowManager", "createWindow", "Created window without GL context (Null backend)");
+
+    setSwapInterval(backend == WindowBackend::Display ? swapInterval : 0);
+
+    const std::string version(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    const std::string vendor(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    const std::string renderer(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    driverId = vendor + "|" + renderer + "|" + version;
 
     Logger::debug("Window", "OpenGL", "OpenGL Info");
-    Logger::debug("Window", "OpenGL", "Version: " + std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION))));
-    Logger::debug("Window", "OpenGL", "Vendor: " + std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))));
-    Logger::debug("Window", "OpenGL", "Renderer: " + std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))));
-    return Logger::debug("WindowManager", "createWindow", "Finish time: " + std::to_string(glfwGetTime()));
+    Logger::debug("Window", "OpenGL", "Version: " + version);
+    Logger::debug("Window", "OpenGL", "Vendor: " + vendor);
+    return Logger::debug("Window", "OpenGL", "Renderer: " + renderer);
+  }
+
+  void WindowManager::setSwapInterval(const int interval) {
+    swapInterval = interval;
+    if (!hasContext()) return;
+
+    int applied = interval;
+    if (applied < 0 && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+      Logger::debug("WindowManager", "setSwapInterval", "Adaptive vsync unsupported, using vsync");
+      applied = 1;
+    }
+    glfwSwapInterval(applied);
+  }
+
+  double WindowManager::getRefreshRate() const {
+    GLFWmonitor* monitor = glfwReady ? glfwGetPrimaryMonitor() : nullptr;
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    return mode && mode->refreshRate > 0 ? static_cast<double>(mode->refreshRate) : 60.0;
+  }
+
+  void WindowManager::waitEvents(const double timeoutSeconds) const {
+    if (!activeWindow) return;
+    if (backend == WindowBackend::Display) {
+      activeWindow->waitEvents(timeoutSeconds);
+      return;
+    }
+
+    // Requests from other threads cannot post an event here, so indefinite
+    // waits are sliced to keep them responsive.
+    constexpr double HEADLESS_SLICE{ 0.01 };
+    const double seconds = timeoutSeconds < 0.0 ? HEADLESS_SLICE : std::min(timeoutSeconds, HEADLESS_SLICE);
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    activeWindow->pollEvents();
   }
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "check.hpp"
+
+#include "starlet-engine/asset_loader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void finishWaitsOnlyForItsBatch() {
+    AssetLoader loader(2);
+    std::atomic<bool> release{ false };
+
+    // Unrelated work that cannot finish until the test lets it.
+    loader.enqueue([&release]() -> AssetLoader::Upload {
+      while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return [] { return true; };
+    });
+
+    int applied = 0;
+    const AssetLoader::Batch batch = loader.createBatch();
+    for (int i = 0; i < 4; ++i)
+      loader.enqueue([&applied]() -> AssetLoader::Upload { return [&applied] { ++applied; return true; }; }, batch);
+
+    STARLET_CHECK(loader.getPending(batch) == 4);
+    STARLET_CHECK(loader.finish(batch));
+    STARLET_CHECK(applied == 4);
+    STARLET_CHECK(loader.getPending(batch) == 0);
+    STARLET_CHECK(loader.getPending() == 1);
+
+    release = true;
+    STARLET_CHECK(loader.finish());
+    STARLET_CHECK(loader.getPending() == 0);
+  }
+
+  void batchReportsFailures() {
+    AssetLoader loader(1);
+    const AssetLoader::Batch batch = loader.createBatch();
+    loader.enqueue([]() -> AssetLoader::Upload { return {}; }, batch);
+    loader.enqueue([]() -> AssetLoader::Upload { return [] { return true; }; }, batch);
+    STARLET_CHECK(!loader.finish(batch));
+
+    // A finished batch is forgotten; a new one starts clean.
+    const AssetLoader::Batch next = loader.createBatch();
+    STARLET_CHECK(next != batch);
+    STARLET_CHECK(loader.finish(next));
+  }
+
+  void runTasksNeverFillTheUploadQueue() {
+    // More tasks than the queue holds, with nothing draining it.
+    AssetLoader loader(2, 4);
+    std::atomic<int> ran{ 0 };
+    const AssetLoader::Batch batch = loader.createBatch();
+    for (int i = 0; i < 32; ++i) loader.run([&ran] { ++ran; return true; }, batch);
+    STARLET_CHECK(loader.wait(batch));
+    STARLET_CHECK(ran == 32);
+    STARLET_CHECK(loader.getPending() == 0);
+
+    const AssetLoader::Batch failing = loader.createBatch();
+    loader.run([] { return false; }, failing);
+    STARLET_CHECK(!loader.wait(failing));
+  }
+
+  void pumpAppliesReadyUploads() {
+    AssetLoader loader(1);
+    int applied = 0;
+    loader.enqueue([&applied]() -> AssetLoader::Upload { return [&applied] { ++applied; return true; }; });
+
+    while (loader.getPending() > 0) {
+      loader.pump();
+      std::this_thread::yield();
+    }
+    STARLET_CHECK(applied == 1);
+  }
+
+  void stepsApplyInOrderWithinTheBudget() {
+    // More steps than the queue holds, so the worker waits on the pumps.
+    AssetLoader loader(1, 4);
+    std::vector<int> order;
+    loader.enqueueSteps([&order] {
+      std::vector<AssetLoader::Upload> steps;
+      for (int i = 0; i < 10; ++i)
+        steps.push_back([&order, i] {
+          order.push_back(i);
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          return true;
+        });
+      return steps;
+    });
+
+    // A 1ms budget is spent by the first step, so each pump applies one.
+    size_t pumps = 0;
+    while (loader.getPending() > 0) {
+      const size_t applied = loader.pump(1.0);
+      STARLET_CHECK(applied <= 1);
+      if (applied > 0) ++pumps;
+      std::this_thread::yield();
+    }
+    STARLET_CHECK(pumps == 10);
+    STARLET_CHECK(order.size() == 10);
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) STARLET_CHECK(order[i] == i);
+
+    loader.enqueueSteps([] { return std::vector<AssetLoader::Upload>(); });
+    STARLET_CHECK(!loader.finish());
+  }
+}
+
+int main() {
+  finishWaitsOnlyForItsBatch();
+  batchReportsFailures();
+  runTasksNeverFillTheUploadQueue();
+  pumpAppliesReadyUploads();
+  stepsApplyInOrderWithinTheBudget();
+  return 0;
+}
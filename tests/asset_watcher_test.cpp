@@ -0,0 +1,85 @@
+#include "check.hpp"
+
+#include "starlet-engine/asset_watcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  void writeFile(const fs::path& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+  }
+
+  bool contains(const std::vector<std::string>& list, const std::string& item) {
+    return std::find(list.begin(), list.end(), item) != list.end();
+  }
+}
+
+int main() {
+  const fs::path root = fs::temp_directory_path() / "starlet_asset_watcher_test";
+  fs::remove_all(root);
+  fs::create_directories(root / "models");
+  fs::create_directories(root / "cache" / "shaders");
+
+  AssetWatcher watcher;
+  watcher.setExcluded({ "cache" });
+  STARLET_CHECK(watcher.start(root.string(), std::chrono::milliseconds(20)));
+  STARLET_CHECK(watcher.isRunning());
+  // Let the mtime fallback take its first snapshot before anything changes.
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // Repeated writes to one file settle into a single change.
+  for (int i = 0; i < 3; ++i) writeFile(root / "models" / "cube.ply", "ply " + std::to_string(i));
+  writeFile(root / "cache" / "shaders" / "shader1.pbin", "binary");
+  writeFile(root / "cache.txt", "not excluded");
+
+  std::vector<std::string> changes;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::chrono::steady_clock::now() < deadline && !(contains(changes, "models/cube.ply") && contains(changes, "cache.txt"))) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    watcher.takeChanges(changes);
+  }
+  // Give an excluded event time to show up if it were going to.
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  watcher.takeChanges(changes);
+  watcher.stop();
+
+  STARLET_CHECK(contains(changes, "models/cube.ply"));
+  STARLET_CHECK(contains(changes, "cache.txt"));
+  STARLET_CHECK(std::count(changes.begin(), changes.end(), "models/cube.ply") == 1);
+  STARLET_CHECK(!contains(changes, "cache/shaders/shader1.pbin"));
+  STARLET_CHECK(!watcher.isRunning());
+
+  // A failed start leaves nothing running.
+  STARLET_CHECK(!watcher.start((root / "missing").string()));
+  STARLET_CHECK(!watcher.isRunning());
+#ifdef __linux__
+  // Out of descriptors, inotify cannot be created.
+  rlimit limit{};
+  getrlimit(RLIMIT_NOFILE, &limit);
+  const int lowest = dup(0);
+  if (lowest >= 0) {
+    close(lowest);
+    rlimit exhausted = limit;
+    exhausted.rlim_cur = static_cast<rlim_t>(lowest);
+    STARLET_CHECK(setrlimit(RLIMIT_NOFILE, &exhausted) == 0);
+    STARLET_CHECK(!watcher.start(root.string()));
+    STARLET_CHECK(!watcher.isRunning());
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+#endif
+
+  fs::remove_all(root);
+  return 0;
+}
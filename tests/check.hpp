@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal assertion helpers for the engine's headless tests. A failed check
+// reports its location and exits non-zero so ctest marks the test failed.
+#define STARLET_CHECK(condition)                                                        \
+  do {                                                                                  \
+    if (!(condition)) {                                                                 \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      std::exit(1);                                                                     \
+    }                                                                                   \
+  } while (0)
+
+#define STARLET_CHECK_NEAR(actual, expected, tolerance) \
+  STARLET_CHECK(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <= (tolerance))
@@ -0,0 +1,115 @@
+#include "check.hpp"
+
+#include "starlet-engine/content_hash.hpp"
+#include "starlet-engine/cooked_assets.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  const fs::path ROOT = fs::temp_directory_path() / "starlet_cooked_assets_test";
+
+  void writeFile(const fs::path& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+  }
+
+  template<typename Header>
+  void stamp(const fs::path& source, Header& header) {
+    STARLET_CHECK(readSourceStamp(source.string(), header.sourceSize, header.sourceModified));
+    STARLET_CHECK(hashFile(source.string(), header.sourceHash));
+  }
+
+  void cookMesh(const fs::path& source) {
+    // One triangle of positions with 16-bit indices.
+    CookedMeshHeader header{ CookedMesh::MAGIC, CookedMesh::FORMAT_VERSION, 0, 0, 0, VERTEX_POSITION, CookedMesh::strideFor(VERTEX_POSITION), 3, 3, 2, 0 };
+    stamp(source, header);
+    std::vector<unsigned char> vertices(3 * header.vertexStride, 0);
+    std::vector<unsigned char> indices = { 0, 0, 1, 0, 2, 0 };
+    STARLET_CHECK(CookedMesh::write(CookedMesh::cookedPathFor(source.string()), header, vertices, indices));
+  }
+
+  void meshStaleness() {
+    const fs::path source = ROOT / "tri.ply";
+    writeFile(source, "ply source a");
+    STARLET_CHECK(CookedMesh::check(source.string()) == CookStatus::Missing);
+    STARLET_CHECK(CookedMesh::check((ROOT / "none.ply").string()) == CookStatus::NoSource);
+
+    cookMesh(source);
+    STARLET_CHECK(CookedMesh::cookedPathFor(source.string()) == (ROOT / "tri.smesh").string());
+    CookedMesh mesh;
+    STARLET_CHECK(mesh.open(source.string()));
+    STARLET_CHECK(mesh.getHeader().indexCount == 3);
+    mesh.close();
+
+    // A touched but unchanged source falls back to the hash and still matches.
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::seconds(5));
+    STARLET_CHECK(CookedMesh::check(source.string()) == CookStatus::Valid);
+
+    // Same size, new content and time: stale.
+    writeFile(source, "ply source b");
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::seconds(10));
+    STARLET_CHECK(CookedMesh::check(source.string()) == CookStatus::Stale);
+
+    // A different size is stale without hashing.
+    writeFile(source, "ply source, longer");
+    STARLET_CHECK(CookedMesh::check(source.string()) == CookStatus::Stale);
+  }
+
+  CookedTextureHeader textureHeader(const fs::path& source, const std::uint32_t mipCount) {
+    CookedTextureHeader header{ CookedTexture::MAGIC, CookedTexture::FORMAT_VERSION, 0, 0, 0,
+      static_cast<std::uint32_t>(CookedTextureFormat::RGBA8), mipCount, 4, 2 };
+    stamp(source, header);
+    return header;
+  }
+
+  void textureValidation() {
+    const fs::path source = ROOT / "brick.bmp";
+    writeFile(source, "bmp source");
+    const std::string cooked = CookedTexture::cookedPathFor(source.string());
+
+    STARLET_CHECK(CookedTexture::mipSizeFor(CookedTextureFormat::RGBA8, 4, 2) == 32);
+    STARLET_CHECK(CookedTexture::mipSizeFor(CookedTextureFormat::BC1, 5, 1) == 16);
+
+    // 4x2, 2x1, 1x1.
+    const std::vector<CookedMipLevel> chain = { { 4, 2, 0, 32 }, { 2, 1, 32, 8 }, { 1, 1, 40, 4 } };
+    const std::vector<unsigned char> pixels(44, 0x7F);
+    STARLET_CHECK(CookedTexture::write(cooked, textureHeader(source, 3), chain, pixels));
+    CookedTexture texture;
+    STARLET_CHECK(texture.open(source.string()));
+    STARLET_CHECK(texture.getMip(2).width == 1);
+    texture.close();
+
+    // Pixel data cut short of the last mip.
+    STARLET_CHECK(CookedTexture::write(cooked, textureHeader(source, 3), chain, std::vector<unsigned char>(43, 0)));
+    STARLET_CHECK(!texture.open(source.string()));
+
+    // A level whose size disagrees with its dimensions.
+    std::vector<CookedMipLevel> wrongSize = chain;
+    wrongSize[1] = { 2, 2, 32, 8 };
+    STARLET_CHECK(CookedTexture::write(cooked, textureHeader(source, 3), wrongSize, pixels));
+    STARLET_CHECK(!texture.open(source.string()));
+
+    // An offset far past the end must not wrap around the bounds check.
+    std::vector<CookedMipLevel> wrapped = chain;
+    wrapped[2].offset = ~std::uint64_t{ 0 } - 2;
+    STARLET_CHECK(CookedTexture::write(cooked, textureHeader(source, 3), wrapped, pixels));
+    STARLET_CHECK(!texture.open(source.string()));
+
+    // More levels declared than the table holds.
+    STARLET_CHECK(CookedTexture::write(cooked, textureHeader(source, 40), chain, pixels));
+    STARLET_CHECK(!texture.open(source.string()));
+  }
+}
+
+int main() {
+  fs::remove_all(ROOT);
+  fs::create_directories(ROOT);
+  meshStaleness();
+  textureValidation();
+  fs::remove_all(ROOT);
+  return 0;
+}
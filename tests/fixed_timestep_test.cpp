@@ -0,0 +1,64 @@
+#include "check.hpp"
+
+#include "starlet-engine/fixed_timestep.hpp"
+#include "starlet-engine/timer.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void stepsAccumulateAcrossFrames() {
+    FixedTimestep timestep;
+    timestep.setTickRate(60.0);
+
+    // Two thirds of a step runs nothing but carries over as alpha.
+    STARLET_CHECK(timestep.advance(1.0 / 90.0) == 0);
+    STARLET_CHECK_NEAR(timestep.getAlpha(), 2.0 / 3.0, 1e-4);
+
+    // The carried remainder plus this frame adds up to exactly one step.
+    STARLET_CHECK(timestep.advance(1.0 / 180.0) == 1);
+    STARLET_CHECK_NEAR(timestep.getAlpha(), 0.0, 1e-4);
+
+    STARLET_CHECK(timestep.advance(2.5 / 60.0) == 2);
+    STARLET_CHECK_NEAR(timestep.getAlpha(), 0.5, 1e-4);
+  }
+
+  void hitchIsCappedByMaxSteps() {
+    FixedTimestep timestep;
+    timestep.setTickRate(60.0);
+    timestep.setMaxSteps(5);
+
+    // A quarter-second hitch is 15 steps; only 5 run and the backlog is dropped,
+    // keeping the fractional remainder so alpha stays continuous.
+    STARLET_CHECK(timestep.advance(15.25 / 60.0) == 5);
+    STARLET_CHECK_NEAR(timestep.getAlpha(), 0.25, 1e-4);
+    STARLET_CHECK(timestep.advance(0.0) == 0);
+  }
+
+  void negativeDeltaIsIgnored() {
+    FixedTimestep timestep;
+    timestep.setTickRate(100.0);
+    STARLET_CHECK(timestep.advance(-1.0) == 0);
+    STARLET_CHECK_NEAR(timestep.getAlpha(), 0.0, 1e-9);
+  }
+
+  void timerDoesNotClampHitches() {
+    Timer timer;
+    STARLET_CHECK(timer.tick() == 0.0f);
+
+    // Anything the timer dropped here would be simulation time lost before
+    // the accumulator could cap it.
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    STARLET_CHECK(timer.tick() >= 0.15f);
+  }
+}
+
+int main() {
+  stepsAccumulateAcrossFrames();
+  hitchIsCappedByMaxSteps();
+  negativeDeltaIsIgnored();
+  timerDoesNotClampHitches();
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include "check.hpp"
+
+#include "starlet-engine/frame_arena.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void allocationsAreAligned() {
+    FrameArena arena(1024);
+    arena.allocate(1, 1);
+    void* aligned = arena.allocate(32, 64);
+    STARLET_CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    double* values = arena.allocateArray<double>(4);
+    STARLET_CHECK(reinterpret_cast<std::uintptr_t>(values) % alignof(double) == 0);
+    STARLET_CHECK(arena.getUsed() <= arena.getCapacity());
+  }
+
+  void overflowGrowsTheBlockOnReset() {
+    FrameArena arena(256);
+    for (int i = 0; i < 8; ++i) arena.allocate(100);
+    STARLET_CHECK(arena.getUsed() > 256);
+
+    arena.reset();
+    STARLET_CHECK(arena.getUsed() == 0);
+    STARLET_CHECK(arena.getCapacity() >= arena.getLastFrameUsed());
+    STARLET_CHECK(arena.getHighWater() == arena.getLastFrameUsed());
+
+    // The grown block now holds the same frame without spilling.
+    const size_t capacity = arena.getCapacity();
+    for (int i = 0; i < 8; ++i) arena.allocate(100);
+    arena.reset();
+    STARLET_CHECK(arena.getCapacity() == capacity);
+  }
+
+  void pmrContainersUseTheArena() {
+    FrameArena arena(4096);
+    ArenaResource resource(arena);
+    {
+      std::pmr::vector<int> scratch(&resource);
+      for (int i = 0; i < 100; ++i) scratch.push_back(i);
+      STARLET_CHECK(scratch[99] == 99);
+    }
+    STARLET_CHECK(arena.getUsed() >= 100 * sizeof(int));
+  }
+
+  void eachThreadIndexHasItsOwnArena() {
+    FrameArenas arenas(3, 512);
+    STARLET_CHECK(&arenas.get(0) != &arenas.get(1));
+    STARLET_CHECK(&arenas.get(1) != &arenas.get(2));
+
+    arenas.get(1).allocate(100);
+    arenas.get(2).allocate(50);
+    STARLET_CHECK(arenas.get(0).getUsed() == 0);
+    arenas.reset();
+    STARLET_CHECK(arenas.getLastFrameUsed() >= 150);
+    STARLET_CHECK(arenas.get(1).getUsed() == 0);
+  }
+
+  void threadsWithoutAnArenaFallBackToTheHeap() {
+    FrameArenas arenas(2, 512);
+    std::pmr::memory_resource& resource = arenas.getResource(~0u);
+    STARLET_CHECK(&resource == std::pmr::new_delete_resource());
+    {
+      std::pmr::vector<int> scratch(&resource);
+      for (int i = 0; i < 100; ++i) scratch.push_back(i);
+      STARLET_CHECK(scratch[99] == 99);
+    }
+    STARLET_CHECK(arenas.get(0).getUsed() == 0);
+    STARLET_CHECK(arenas.get(1).getUsed() == 0);
+  }
+}
+
+int main() {
+  allocationsAreAligned();
+  overflowGrowsTheBlockOnReset();
+  pmrContainersUseTheArena();
+  eachThreadIndexHasItsOwnArena();
+  threadsWithoutAnArenaFallBackToTheHeap();
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include "check.hpp"
+
+#include "starlet-engine/frame_demand.hpp"
+
+using namespace Starlet::Engine;
+
+namespace {
+  void requestsAreConsumedByFrames() {
+    FrameDemand demand;
+    const Clock::Ticks now = Clock::fromSeconds(100.0);
+
+    // The first frame is always owed.
+    STARLET_CHECK(demand.getWaitSeconds(now) == 0.0);
+    demand.beginFrame(now);
+    STARLET_CHECK(demand.getWaitSeconds(now) < 0.0);
+
+    demand.markDirty(2);
+    demand.beginFrame(now);
+    STARLET_CHECK(demand.getWaitSeconds(now) == 0.0);
+    demand.beginFrame(now);
+    STARLET_CHECK(demand.getWaitSeconds(now) < 0.0);
+  }
+
+  void timersWaitUntilDue() {
+    FrameDemand demand;
+    const Clock::Ticks now = Clock::fromSeconds(100.0);
+    demand.beginFrame(now);
+
+    demand.requestFrameAt(now + Clock::fromSeconds(0.5));
+    demand.requestFrameAt(now + Clock::fromSeconds(0.2));
+    STARLET_CHECK_NEAR(demand.getWaitSeconds(now), 0.2, 1e-6);
+
+    const Clock::Ticks due = now + Clock::fromSeconds(0.2);
+    STARLET_CHECK(demand.getWaitSeconds(due) == 0.0);
+    demand.beginFrame(due);
+    STARLET_CHECK(demand.getWaitSeconds(due) < 0.0);
+  }
+
+  void keysAndButtonsAreHeldApart() {
+    FrameDemand demand;
+    const Clock::Ticks now = Clock::fromSeconds(100.0);
+    demand.beginFrame(now);
+
+    // Key 0 and mouse button 0 share a code but not a held set.
+    demand.setKeyHeld(0, true);
+    demand.setButtonHeld(0, true);
+    STARLET_CHECK(demand.isContinuous());
+    demand.setKeyHeld(0, false);
+    STARLET_CHECK(demand.isContinuous());
+    demand.setButtonHeld(0, false);
+    STARLET_CHECK(!demand.isContinuous());
+
+    // Releases go missing while minimised, so iconifying drops every hold.
+    demand.setKeyHeld(65, true);
+    demand.setButtonHeld(1, true);
+    demand.setIconified(true);
+    STARLET_CHECK(!demand.isContinuous());
+    STARLET_CHECK(demand.getWaitSeconds(now) < 0.0);
+    demand.setIconified(false);
+    STARLET_CHECK(demand.getWaitSeconds(now) == 0.0);
+  }
+
+  void animationsAndBackgroundRate() {
+    FrameDemand demand;
+    const Clock::Ticks now = Clock::fromSeconds(100.0);
+    demand.beginFrame(now);
+
+    demand.beginAnimation();
+    STARLET_CHECK(demand.getWaitSeconds(now) == 0.0);
+
+    // Unfocused, continuous frames are held to the background rate.
+    demand.setBackgroundFrameRate(10.0);
+    demand.setFocused(false);
+    STARLET_CHECK_NEAR(demand.getWaitSeconds(now), 0.1, 1e-6);
+    demand.setFocused(true);
+
+    // Ending the animation owes one frame for its final state.
+    demand.endAnimation();
+    STARLET_CHECK(!demand.isContinuous());
+    STARLET_CHECK(demand.getWaitSeconds(now) == 0.0);
+    demand.beginFrame(now);
+    STARLET_CHECK(demand.getWaitSeconds(now) < 0.0);
+  }
+}
+
+int main() {
+  requestsAreConsumedByFrames();
+  timersWaitUntilDue();
+  keysAndButtonsAreHeldApart();
+  animationsAndBackgroundRate();
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "check.hpp"
+
+#include "starlet-engine/frame_pacer.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void swapIntervalFollowsMode() {
+    FramePacer pacer;
+    STARLET_CHECK(pacer.getSwapInterval() == 1);
+    pacer.setMode(PresentMode::Adaptive);
+    STARLET_CHECK(pacer.getSwapInterval() == -1);
+    pacer.setMode(PresentMode::Uncapped);
+    STARLET_CHECK(pacer.getSwapInterval() == 0);
+
+    // Limited without a rate is rejected and leaves the mode alone.
+    pacer.setMode(PresentMode::Limited, 0.0);
+    STARLET_CHECK(pacer.getMode() == PresentMode::Uncapped);
+    pacer.setMode(PresentMode::Limited, 120.0);
+    STARLET_CHECK(pacer.getMode() == PresentMode::Limited);
+    STARLET_CHECK(pacer.getSwapInterval() == 0);
+  }
+
+  void limiterHoldsTheTargetRate() {
+    FramePacer pacer;
+    pacer.setMode(PresentMode::Limited, 200.0);
+
+    pacer.endFrame();
+    const Clock::Ticks start = Clock::now();
+    for (int i = 0; i < 20; ++i) pacer.endFrame();
+    const double elapsed = Clock::toSeconds(Clock::now() - start);
+
+    // 20 frames at 5 ms each; the limiter never runs early.
+    STARLET_CHECK(elapsed >= 0.095);
+    STARLET_CHECK(pacer.getFrameTimes().getCount() == 20);
+  }
+
+  void lateFramesCountAsMissed() {
+    FramePacer pacer;
+    pacer.setMode(PresentMode::Limited, 100.0);
+    pacer.endFrame();
+    pacer.endFrame();
+    const std::uint64_t before = pacer.getMissedDeadlines();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pacer.endFrame();
+    STARLET_CHECK(pacer.getMissedDeadlines() == before + 1);
+
+    pacer.resetStats();
+    STARLET_CHECK(pacer.getMissedDeadlines() == 0);
+    STARLET_CHECK(pacer.getFrameTimes().getCount() == 0);
+  }
+
+  void vsyncIntervalsOverOneAndAHalfRefreshesAreMissed() {
+    FramePacer pacer;
+    pacer.setRefreshRate(100.0);
+    pacer.endFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    pacer.endFrame();
+    STARLET_CHECK(pacer.getMissedDeadlines() == 1);
+  }
+
+  void idleGapsAreNotIntervals() {
+    FramePacer pacer;
+    pacer.setRefreshRate(100.0);
+    pacer.endFrame();
+    pacer.endFrame();
+    const std::uint64_t recorded = pacer.getFrameTimes().getCount();
+
+    // An on-demand wait resets the pacer, so the gap is neither an interval nor a miss.
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    pacer.resetInterval();
+    pacer.endFrame();
+    STARLET_CHECK(pacer.getFrameTimes().getCount() == recorded);
+    STARLET_CHECK(pacer.getMissedDeadlines() == 0);
+
+    // Limited mode re-anchors its deadline rather than reporting the gap as late.
+    pacer.setMode(PresentMode::Limited, 100.0);
+    pacer.endFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pacer.resetInterval();
+    pacer.endFrame();
+    STARLET_CHECK(pacer.getMissedDeadlines() == 0);
+  }
+}
+
+int main() {
+  swapIntervalFollowsMode();
+  limiterHoldsTheTargetRate();
+  lateFramesCountAsMissed();
+  vsyncIntervalsOverOneAndAHalfRefreshesAreMissed();
+  idleGapsAreNotIntervals();
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include "check.hpp"
+
+#include "starlet-engine/input_event_queue.hpp"
+#include "starlet-engine/latency_histogram.hpp"
+
+#include <thread>
+
+using namespace Starlet::Engine;
+
+namespace {
+  InputEvent keyEvent(const int key, const Clock::Ticks timestamp) {
+    InputEvent event;
+    event.type = InputEventType::Key;
+    event.timestamp = timestamp;
+    event.key.key = key;
+    return event;
+  }
+
+  void consumeReturnsEventsInOrder() {
+    InputEventQueue<4> queue;
+    STARLET_CHECK(queue.consume().empty());
+
+    for (int i = 0; i < 3; ++i) STARLET_CHECK(queue.push(keyEvent(i, 100 + i)));
+    const InputEventSpan events = queue.consume();
+    STARLET_CHECK(events.size == 3);
+    int expected = 0;
+    for (const InputEvent& event : events) {
+      STARLET_CHECK(event.key.key == expected);
+      STARLET_CHECK(event.timestamp == static_cast<Clock::Ticks>(100 + expected));
+      ++expected;
+    }
+    STARLET_CHECK(queue.consume().empty());
+  }
+
+  void fullQueueDropsNewEvents() {
+    InputEventQueue<4> queue;
+    for (int i = 0; i < 4; ++i) STARLET_CHECK(queue.push(keyEvent(i, 0)));
+    STARLET_CHECK(!queue.push(keyEvent(99, 0)));
+    STARLET_CHECK(queue.getDropped() == 1);
+
+    const InputEventSpan events = queue.consume();
+    STARLET_CHECK(events.size == 4);
+    STARLET_CHECK(events.data[3].key.key == 3);
+
+    // Consuming frees the ring and the indices keep wrapping correctly.
+    for (int round = 0; round < 10; ++round) {
+      STARLET_CHECK(queue.push(keyEvent(round, 0)));
+      STARLET_CHECK(queue.consume().size == 1);
+    }
+  }
+
+  void producerThreadHandsOffEveryEvent() {
+    InputEventQueue<64> queue;
+    constexpr int COUNT = 10000;
+    std::thread producer([&queue] {
+      for (int i = 0; i < COUNT; ++i)
+        while (!queue.push(keyEvent(i, 0))) std::this_thread::yield();
+    });
+
+    int next = 0;
+    while (next < COUNT) {
+      for (const InputEvent& event : queue.consume()) {
+        STARLET_CHECK(event.key.key == next);
+        ++next;
+      }
+    }
+    producer.join();
+  }
+
+  void histogramBucketsAndPercentiles() {
+    LatencyHistogram histogram;
+    STARLET_CHECK(histogram.getPercentileUpperBound(0.99) == 0.0);
+
+    for (int i = 0; i < 90; ++i) histogram.record(3.0);
+    for (int i = 0; i < 9; ++i) histogram.record(15.0);
+    histogram.record(250.0);
+
+    STARLET_CHECK(histogram.getCount() == 100);
+    STARLET_CHECK(histogram.getBucket(2) == 90);
+    STARLET_CHECK(histogram.getBucket(5) == 9);
+    STARLET_CHECK(histogram.getBucket(LatencyHistogram::BUCKET_COUNT - 1) == 1);
+    STARLET_CHECK(histogram.getPercentileUpperBound(0.5) == 4.0);
+    STARLET_CHECK(histogram.getPercentileUpperBound(0.95) == 16.7);
+    STARLET_CHECK_NEAR(histogram.getPercentileUpperBound(1.0), 250.0, 1e-9);
+    STARLET_CHECK_NEAR(histogram.getMaxMilliseconds(), 250.0, 1e-9);
+
+    histogram.clear();
+    STARLET_CHECK(histogram.getCount() == 0);
+    STARLET_CHECK(histogram.getMaxMilliseconds() == 0.0);
+  }
+}
+
+int main() {
+  consumeReturnsEventsInOrder();
+  fullQueueDropsNewEvents();
+  producerThreadHandsOffEveryEvent();
+  histogramBucketsAndPercentiles();
+  return 0;
+}
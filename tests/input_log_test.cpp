@@ -0,0 +1,107 @@
+#include "check.hpp"
+
+#include "starlet-engine/input_log.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  const fs::path ROOT = fs::temp_directory_path() / "starlet_input_log_test";
+
+  InputEvent keyEvent(const int key, const int action) {
+    InputEvent event;
+    event.type = InputEventType::Key;
+    event.key.key = key;
+    event.key.action = action;
+    return event;
+  }
+
+  InputEvent buttonEvent(const int button, const int action) {
+    InputEvent event;
+    event.type = InputEventType::MouseButton;
+    event.button.button = button;
+    event.button.action = action;
+    return event;
+  }
+
+  void roundTrip() {
+    const std::string path = (ROOT / "session.sinp").string();
+    const std::string timingPath = (ROOT / "timing.csv").string();
+    {
+      InputRecorder recorder;
+      STARLET_CHECK(recorder.open(path));
+      const InputEvent first[] = { keyEvent(65, 1), buttonEvent(0, 1) };
+      recorder.recordFrame(0.016f, 10.0, 20.0, { first, 2 });
+      recorder.recordFrame(0.033f, 11.5, 19.0, {});
+      InputEvent scroll;
+      scroll.type = InputEventType::Scroll;
+      recorder.recordFrame(0.020f, 12.0, 18.0, { &scroll, 1 });
+      STARLET_CHECK(recorder.getFrameCount() == 3);
+    }
+
+    InputReplay replay;
+    STARLET_CHECK(replay.open(path, timingPath));
+    InputLogFrame frame;
+
+    STARLET_CHECK(replay.next(frame));
+    STARLET_CHECK(frame.deltaTime == 0.016f);
+    STARLET_CHECK(frame.cursorX == 10.0 && frame.cursorY == 20.0);
+    STARLET_CHECK(frame.events.size() == 2);
+    STARLET_CHECK(frame.events[0].type == InputEventType::Key);
+    STARLET_CHECK(frame.events[0].key.key == 65 && frame.events[0].key.action == 1);
+    STARLET_CHECK(frame.events[1].type == InputEventType::MouseButton);
+    STARLET_CHECK(frame.events[1].button.button == 0 && frame.events[1].button.action == 1);
+    replay.recordTiming(1.0, 2.0);
+
+    STARLET_CHECK(replay.next(frame));
+    STARLET_CHECK(frame.deltaTime == 0.033f);
+    STARLET_CHECK(frame.events.empty());
+
+    STARLET_CHECK(replay.next(frame));
+    STARLET_CHECK(frame.events.size() == 1 && frame.events[0].type == InputEventType::Scroll);
+    STARLET_CHECK(!replay.next(frame));
+    STARLET_CHECK(replay.getFrameIndex() == 3);
+    replay.close();
+
+    std::ifstream timing(timingPath);
+    std::string header, row;
+    std::getline(timing, header);
+    STARLET_CHECK(std::getline(timing, row) && row.rfind("0,16.0000,1.0000,2.0000", 0) == 0);
+  }
+
+  void rejectsBadLogs() {
+    InputReplay replay;
+    STARLET_CHECK(!replay.open((ROOT / "missing.sinp").string()));
+
+    const fs::path garbage = ROOT / "garbage.sinp";
+    std::ofstream(garbage, std::ios::binary) << "not an input log at all";
+    STARLET_CHECK(!replay.open(garbage.string()));
+
+    // A log cut off inside a frame stops at the last whole frame.
+    const std::string path = (ROOT / "cut.sinp").string();
+    {
+      InputRecorder recorder;
+      STARLET_CHECK(recorder.open(path));
+      const InputEvent events[] = { keyEvent(1, 1), keyEvent(2, 1) };
+      recorder.recordFrame(0.016f, 0.0, 0.0, { events, 1 });
+      recorder.recordFrame(0.016f, 0.0, 0.0, { events, 2 });
+    }
+    fs::resize_file(path, fs::file_size(path) - 3);
+    STARLET_CHECK(replay.open(path));
+    InputLogFrame frame;
+    STARLET_CHECK(replay.next(frame));
+    STARLET_CHECK(!replay.next(frame));
+  }
+}
+
+int main() {
+  fs::remove_all(ROOT);
+  fs::create_directories(ROOT);
+  roundTrip();
+  rejectsBadLogs();
+  fs::remove_all(ROOT);
+  return 0;
+}
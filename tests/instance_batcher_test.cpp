@@ -0,0 +1,113 @@
+#include "check.hpp"
+
+#include "starlet-engine/instance_batcher.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace Starlet::Engine;
+
+namespace {
+  const float IDENTITY[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+
+  void groupsByKey() {
+    InstanceBatcher batcher;
+    const InstanceBatchKey cube{ 1, 36, 0 };
+    const InstanceBatchKey shortCube{ 1, 36, 0, 0x1403 }; // GL_UNSIGNED_SHORT
+    const InstanceBatchKey textured{ 1, 36, 5 };
+
+    batcher.add(cube, IDENTITY);
+    batcher.add(cube, IDENTITY);
+    batcher.add(shortCube, IDENTITY);
+    batcher.add(textured, IDENTITY);
+    InstanceBatchKey red = cube;
+    red.colour = packColour(1.0f, 0.0f, 0.0f, 1.0f);
+    batcher.add(red, IDENTITY);
+    STARLET_CHECK(batcher.getBatchCount() == 4);
+    STARLET_CHECK(batcher.getInstanceCount() == 5);
+    STARLET_CHECK(batcher.getEntityDrawCalls() == 5);
+    STARLET_CHECK(red.colour == 0xFF0000FFu);
+    STARLET_CHECK(packColour(2.0f, -1.0f, 0.6f, 1.0f) == 0xFF0099FFu);
+  }
+
+  void turnsTheModelUniformIntoAnAttribute() {
+    const std::string modern = "#version 330 core\nlayout(location = 0) in vec3 vPosition;\nuniform mat4 model;\nuniform mat4 view;\n"
+      "void main() { gl_Position = view * model * vec4(vPosition, 1.0); }\n";
+    const std::string instanced = InstanceBatcher::instancedVertexSource(modern);
+    STARLET_CHECK(instanced.find("layout(location = 8) in mat4 model;") != std::string::npos);
+    STARLET_CHECK(instanced.find("uniform mat4 model;") == std::string::npos);
+    STARLET_CHECK(instanced.find("uniform mat4 view;") != std::string::npos);
+    STARLET_CHECK(instanced.find("#extension") == std::string::npos);
+
+    // Older GLSL gets the explicit location extension right after #version.
+    const std::string old = "#version 150\nin vec3 p;\nuniform  highp mat4  world ;\nvoid main() { gl_Position = world * vec4(p, 1.0); }\n";
+    const std::string upgraded = InstanceBatcher::instancedVertexSource(old, "world", 4);
+    STARLET_CHECK(upgraded.find("#version 150\n#extension GL_ARB_explicit_attrib_location : require\n") == 0);
+    STARLET_CHECK(upgraded.find("layout(location = 4) in mat4 world;") != std::string::npos);
+
+    STARLET_CHECK(InstanceBatcher::instancedVertexSource(modern, "transform").empty());
+  }
+
+  void rejectsBadRefs() {
+    InstanceBatcher batcher;
+    const InstanceRef first = batcher.add({ 1, 36, 0 }, IDENTITY);
+    STARLET_CHECK(first.isValid());
+    STARLET_CHECK(batcher.setTransform(first, IDENTITY));
+
+    STARLET_CHECK(!batcher.setTransform(InstanceRef{}, IDENTITY));
+    STARLET_CHECK(!batcher.setTransform({ first.batch, first.slot + 1, first.generation }, IDENTITY));
+    STARLET_CHECK(!batcher.setTransform({ first.batch + 1, 0, first.generation }, IDENTITY));
+
+    // A ref from before clear() stays rejected even once its slot is reused.
+    batcher.clear();
+    STARLET_CHECK(batcher.empty());
+    STARLET_CHECK(!batcher.setTransform(first, IDENTITY));
+    const InstanceRef second = batcher.add({ 1, 36, 0 }, IDENTITY);
+    STARLET_CHECK(second.batch == first.batch && second.slot == first.slot);
+    STARLET_CHECK(!batcher.setTransform(first, IDENTITY));
+    STARLET_CHECK(batcher.setTransform(second, IDENTITY));
+  }
+
+  void interpolatesTheLatestStep() {
+    InstanceBatcher batcher;
+    const InstanceRef moving = batcher.add({ 1, 36, 0 }, IDENTITY);
+    const InstanceRef still = batcher.add({ 1, 36, 0 }, IDENTITY);
+    float moved[16];
+    std::copy(IDENTITY, IDENTITY + 16, moved);
+    float out[16];
+
+    // Two moves in one step blend from where the step started.
+    batcher.beginStep();
+    moved[12] = 1.0f;
+    STARLET_CHECK(batcher.setTransform(moving, moved));
+    moved[12] = 4.0f;
+    STARLET_CHECK(batcher.setTransform(moving, moved));
+    STARLET_CHECK(batcher.getInterpolatedTransform(moving, 0.25f, out));
+    STARLET_CHECK_NEAR(out[12], 1.0f, 1e-6f);
+    STARLET_CHECK(batcher.getInterpolatedTransform(moving, 1.0f, out));
+    STARLET_CHECK_NEAR(out[12], 4.0f, 1e-6f);
+    STARLET_CHECK(batcher.getInterpolatedTransform(still, 0.25f, out));
+    STARLET_CHECK_NEAR(out[12], 0.0f, 1e-6f);
+
+    // The next step blends from the last one's result.
+    batcher.beginStep();
+    moved[12] = 6.0f;
+    STARLET_CHECK(batcher.setTransform(moving, moved));
+    STARLET_CHECK(batcher.getInterpolatedTransform(moving, 0.5f, out));
+    STARLET_CHECK_NEAR(out[12], 5.0f, 1e-6f);
+
+    // A step without a move settles the instance where it ended.
+    batcher.beginStep();
+    STARLET_CHECK(batcher.getInterpolatedTransform(moving, 0.5f, out));
+    STARLET_CHECK_NEAR(out[12], 6.0f, 1e-6f);
+    STARLET_CHECK(!batcher.getInterpolatedTransform(InstanceRef{}, 0.5f, out));
+  }
+}
+
+int main() {
+  groupsByKey();
+  turnsTheModelUniformIntoAnAttribute();
+  rejectsBadRefs();
+  interpolatesTheLatestStep();
+  return 0;
+}
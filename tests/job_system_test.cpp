@@ -0,0 +1,79 @@
+#include "check.hpp"
+
+#include "starlet-engine/job_system.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void parallelForCoversEveryItemOnce() {
+    JobSystem jobs(3);
+    std::vector<int> hits(10000, 0);
+    jobs.parallelFor(hits.size(), 64, [&hits](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i) ++hits[i];
+    });
+    for (const int hit : hits) STARLET_CHECK(hit == 1);
+  }
+
+  void nestedParallelForCompletes() {
+    JobSystem jobs(2);
+    std::atomic<size_t> total{ 0 };
+    jobs.parallelFor(16, 1, [&jobs, &total](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i)
+        jobs.parallelFor(100, 10, [&total](const size_t b, const size_t e) { total += e - b; });
+    });
+    STARLET_CHECK(total == 1600);
+  }
+
+  void threadIndicesIdentifyOwnerWorkersAndForeignThreads() {
+    JobSystem jobs(2);
+    STARLET_CHECK(jobs.getCurrentThreadIndex() == 0);
+
+    std::atomic<unsigned int> workerIndex{ 0 };
+    JobCounter counter;
+    jobs.submit([&jobs, &workerIndex] { workerIndex = jobs.getCurrentThreadIndex(); }, &counter);
+    jobs.wait(counter);
+    // The owner may have run the job itself while waiting.
+    STARLET_CHECK(workerIndex <= jobs.getWorkerCount());
+
+    unsigned int foreignIndex = 0;
+    std::thread([&jobs, &foreignIndex] { foreignIndex = jobs.getCurrentThreadIndex(); }).join();
+    STARLET_CHECK(foreignIndex == JobSystem::FOREIGN);
+
+    // Rebinding the owner moves index 0 to the calling thread.
+    unsigned int reboundIndex = JobSystem::FOREIGN;
+    std::thread([&jobs, &reboundIndex] {
+      jobs.setOwnerThread();
+      reboundIndex = jobs.getCurrentThreadIndex();
+    }).join();
+    STARLET_CHECK(reboundIndex == 0);
+    STARLET_CHECK(jobs.getCurrentThreadIndex() == JobSystem::FOREIGN);
+    jobs.setOwnerThread();
+  }
+
+  void foreignThreadsWaitWithoutRunningJobs() {
+    JobSystem jobs(1);
+    std::atomic<bool> ranOnForeign{ false };
+
+    std::thread([&jobs, &ranOnForeign] {
+      const std::thread::id self = std::this_thread::get_id();
+      JobCounter counter;
+      for (int i = 0; i < 64; ++i)
+        jobs.submit([self, &ranOnForeign] { if (std::this_thread::get_id() == self) ranOnForeign = true; }, &counter);
+      jobs.wait(counter);
+      STARLET_CHECK(counter.isDone());
+    }).join();
+    STARLET_CHECK(!ranOnForeign);
+  }
+}
+
+int main() {
+  parallelForCoversEveryItemOnce();
+  nestedParallelForCompletes();
+  threadIndicesIdentifyOwnerWorkersAndForeignThreads();
+  foreignThreadsWaitWithoutRunningJobs();
+  return 0;
+}
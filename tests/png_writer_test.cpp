@@ -0,0 +1,244 @@
+#include "check.hpp"
+
+#include "starlet-engine/png_writer.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  // Bitwise references, independent of the writer's table-driven versions.
+  std::uint32_t referenceCrc(const unsigned char* data, const size_t size) {
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+      crc ^= data[i];
+      for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc ^ 0xFFFFFFFFu;
+  }
+
+  std::uint32_t referenceAdler(const std::vector<unsigned char>& data) {
+    std::uint32_t a = 1, b = 0;
+    for (const unsigned char byte : data) {
+      a = (a + byte) % 65521;
+      b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+  }
+
+  std::uint32_t readBigEndian(const unsigned char* in) {
+    return std::uint32_t{ in[0] } << 24 | std::uint32_t{ in[1] } << 16 | std::uint32_t{ in[2] } << 8 | in[3];
+  }
+
+  // LSB-first bit reader over a deflate stream.
+  struct BitReader {
+    const std::vector<unsigned char>& data;
+    size_t at;
+    unsigned int bit{ 0 };
+
+    bool next(std::uint32_t& out) {
+      if (at >= data.size()) return false;
+      out = (data[at] >> bit) & 1u;
+      if (++bit == 8) { bit = 0; ++at; }
+      return true;
+    }
+    bool bits(const unsigned int count, std::uint32_t& out) {
+      out = 0;
+      for (unsigned int i = 0; i < count; ++i) {
+        std::uint32_t b;
+        if (!next(b)) return false;
+        out |= b << i;
+      }
+      return true;
+    }
+    // Huffman codes are packed most significant bit first.
+    bool code(const unsigned int count, std::uint32_t& out) {
+      out = 0;
+      for (unsigned int i = 0; i < count; ++i) {
+        std::uint32_t b;
+        if (!next(b)) return false;
+        out = (out << 1) | b;
+      }
+      return true;
+    }
+  };
+
+  bool fixedSymbol(BitReader& in, std::uint32_t& symbol) {
+    std::uint32_t code;
+    if (!in.code(7, code)) return false;
+    if (code <= 0x17) { symbol = 256 + code; return true; }
+    std::uint32_t b;
+    if (!in.next(b)) return false;
+    code = (code << 1) | b;
+    if (code >= 0x30 && code <= 0xBF) { symbol = code - 0x30; return true; }
+    if (code >= 0xC0 && code <= 0xC7) { symbol = 280 + code - 0xC0; return true; }
+    if (!in.next(b)) return false;
+    code = (code << 1) | b;
+    if (code >= 0x190 && code <= 0x1FF) { symbol = 144 + code - 0x190; return true; }
+    return false;
+  }
+
+  // Stored and fixed-Huffman blocks, the two kinds the writer emits.
+  bool inflate(const std::vector<unsigned char>& zlib, std::vector<unsigned char>& out, size_t& end) {
+    static const unsigned int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const unsigned int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const unsigned int DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const unsigned int DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    BitReader in{ zlib, 2 };
+    for (std::uint32_t last = 0; !last; ) {
+      std::uint32_t type;
+      if (!in.bits(1, last) || !in.bits(2, type)) return false;
+      if (type == 0) {
+        if (in.bit != 0) { in.bit = 0; ++in.at; }
+        if (in.at + 4 > zlib.size()) return false;
+        const std::uint16_t length = static_cast<std::uint16_t>(zlib[in.at] | zlib[in.at + 1] << 8);
+        const std::uint16_t inverse = static_cast<std::uint16_t>(zlib[in.at + 2] | zlib[in.at + 3] << 8);
+        if (static_cast<std::uint16_t>(~length) != inverse || in.at + 4 + length > zlib.size()) return false;
+        out.insert(out.end(), zlib.begin() + in.at + 4, zlib.begin() + in.at + 4 + length);
+        in.at += 4 + length;
+        continue;
+      }
+      if (type != 1) return false;
+
+      for (;;) {
+        std::uint32_t symbol;
+        if (!fixedSymbol(in, symbol)) return false;
+        if (symbol < 256) { out.push_back(static_cast<unsigned char>(symbol)); continue; }
+        if (symbol == 256) break;
+        if (symbol > 285) return false;
+
+        std::uint32_t extra, distanceCode;
+        if (!in.bits(LENGTH_EXTRA[symbol - 257], extra)) return false;
+        const size_t length = LENGTH_BASE[symbol - 257] + extra;
+        if (!in.code(5, distanceCode) || distanceCode > 29 || !in.bits(DISTANCE_EXTRA[distanceCode], extra)) return false;
+        const size_t distance = DISTANCE_BASE[distanceCode] + extra;
+        if (distance > out.size()) return false;
+        for (size_t i = 0; i < length; ++i) out.push_back(out[out.size() - distance]);
+      }
+    }
+    end = in.at + (in.bit != 0 ? 1 : 0);
+    return true;
+  }
+
+  // Walks the chunks, checking each CRC, and inflates the IDAT stream.
+  bool readPng(const std::string& path, std::uint32_t& width, std::uint32_t& height, std::vector<unsigned char>& scanlines) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (bytes.size() < 8 || std::memcmp(bytes.data(), SIGNATURE, 8) != 0) return false;
+
+    std::vector<unsigned char> zlib;
+    bool ended = false;
+    for (size_t at = 8; at + 12 <= bytes.size() && !ended; ) {
+      const std::uint32_t length = readBigEndian(&bytes[at]);
+      if (at + 12 + length > bytes.size()) return false;
+      const unsigned char* type = &bytes[at + 4];
+      const unsigned char* data = type + 4;
+      if (readBigEndian(data + length) != referenceCrc(type, length + 4)) return false;
+
+      if (std::memcmp(type, "IHDR", 4) == 0) {
+        width = readBigEndian(data);
+        height = readBigEndian(data + 4);
+        if (data[8] != 8 || data[9] != 6) return false; // 8-bit RGBA
+      }
+      else if (std::memcmp(type, "IDAT", 4) == 0) zlib.insert(zlib.end(), data, data + length);
+      else if (std::memcmp(type, "IEND", 4) == 0) ended = true;
+      at += 12 + length;
+    }
+    if (!ended || zlib.size() < 6 || ((zlib[0] << 8) | zlib[1]) % 31 != 0) return false;
+
+    scanlines.clear();
+    size_t end = 0;
+    if (!inflate(zlib, scanlines, end)) return false;
+    return end + 4 == zlib.size() && readBigEndian(&zlib[end]) == referenceAdler(scanlines);
+  }
+
+  // Undoes the None and Up filters in place, returning false on any other.
+  bool unfilter(std::vector<unsigned char>& scanlines, const size_t stride, const unsigned int height) {
+    for (unsigned int y = 0; y < height; ++y) {
+      unsigned char* line = &scanlines[y * (stride + 1)];
+      if (line[0] == 0) continue;
+      if (line[0] != 2) return false;
+      if (y == 0) continue;
+      const unsigned char* above = line - (stride + 1);
+      for (size_t i = 1; i <= stride; ++i) line[i] = static_cast<unsigned char>(line[i] + above[i]);
+    }
+    return true;
+  }
+
+  size_t writeAndMeasure(const std::vector<unsigned char>& rgba, const unsigned int width, const unsigned int height, const PngCompression compression) {
+    const std::string path = (fs::temp_directory_path() / "starlet_png_writer_size.png").string();
+    STARLET_CHECK(writePng(path, width, height, rgba.data(), false, compression));
+    std::uint32_t readWidth = 0, readHeight = 0;
+    std::vector<unsigned char> scanlines;
+    STARLET_CHECK(readPng(path, readWidth, readHeight, scanlines));
+    STARLET_CHECK(unfilter(scanlines, size_t{ width } * 4, height));
+    for (unsigned int y = 0; y < height; ++y)
+      STARLET_CHECK(std::memcmp(&scanlines[y * (width * 4 + 1) + 1], &rgba[size_t{ y } * width * 4], size_t{ width } * 4) == 0);
+    const size_t size = static_cast<size_t>(fs::file_size(path));
+    fs::remove(path);
+    return size;
+  }
+
+  void fastCompressionShrinksRenderedFrames() {
+    // A flat background with a gradient band, like a rendered frame.
+    const unsigned int width = 320, height = 200;
+    std::vector<unsigned char> rgba(size_t{ width } * height * 4);
+    for (unsigned int y = 0; y < height; ++y)
+      for (unsigned int x = 0; x < width; ++x) {
+        unsigned char* pixel = &rgba[(size_t{ y } * width + x) * 4];
+        pixel[0] = 30;
+        pixel[1] = static_cast<unsigned char>(y > 50 && y < 150 ? x / 2 : 40);
+        pixel[2] = static_cast<unsigned char>(y);
+        pixel[3] = 255;
+      }
+
+    const size_t stored = writeAndMeasure(rgba, width, height, PngCompression::Stored);
+    const size_t fast = writeAndMeasure(rgba, width, height, PngCompression::Fast);
+    STARLET_CHECK(fast * 10 < stored);
+  }
+
+  void roundTrip(const unsigned int width, const unsigned int height, const bool bottomUp, const PngCompression compression) {
+    std::vector<unsigned char> rgba(size_t{ width } * height * 4);
+    for (size_t i = 0; i < rgba.size(); ++i) rgba[i] = static_cast<unsigned char>(i * 7 + i / 13);
+
+    const std::string path = (fs::temp_directory_path() / "starlet_png_writer_test.png").string();
+    STARLET_CHECK(writePng(path, width, height, rgba.data(), bottomUp, compression));
+
+    std::uint32_t readWidth = 0, readHeight = 0;
+    std::vector<unsigned char> scanlines;
+    STARLET_CHECK(readPng(path, readWidth, readHeight, scanlines));
+    STARLET_CHECK(readWidth == width && readHeight == height);
+
+    const size_t stride = size_t{ width } * 4;
+    STARLET_CHECK(scanlines.size() == height * (stride + 1));
+    if (scanlines.size() != height * (stride + 1)) return;
+    STARLET_CHECK(unfilter(scanlines, stride, height));
+    for (unsigned int y = 0; y < height; ++y) {
+      const unsigned char* line = &scanlines[y * (stride + 1)];
+      const unsigned int source = bottomUp ? height - 1 - y : y;
+      STARLET_CHECK(std::memcmp(line + 1, &rgba[source * stride], stride) == 0);
+    }
+    fs::remove(path);
+  }
+}
+
+int main() {
+  for (const PngCompression compression : { PngCompression::Stored, PngCompression::Fast }) {
+    roundTrip(3, 2, false, compression);
+    roundTrip(5, 4, true, compression);
+    // Over 64 KiB of scanlines, so a stored stream spans several blocks.
+    roundTrip(150, 120, true, compression);
+  }
+  fastCompressionShrinksRenderedFrames();
+
+  STARLET_CHECK(!writePng((fs::temp_directory_path() / "starlet_png_empty.png").string(), 0, 4, nullptr, false));
+  return 0;
+}
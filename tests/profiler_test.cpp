@@ -0,0 +1,83 @@
+#include "check.hpp"
+
+#include "starlet-engine/profiler.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace Starlet::Engine;
+
+namespace {
+  void bufferDropsWhenFull() {
+    auto buffer = std::make_unique<ProfileBuffer>(3);
+    for (size_t i = 0; i < ProfileBuffer::CAPACITY + 10; ++i) buffer->push("zone", i, i + 1);
+    STARLET_CHECK(buffer->getDropped() == 10);
+
+    size_t drained = 0;
+    Clock::Ticks previous = 0;
+    bool ordered = true;
+    buffer->drain([&](const ProfileEvent& event) {
+      ordered = ordered && event.threadId == 3 && (drained == 0 || event.start > previous);
+      previous = event.start;
+      ++drained;
+    });
+    STARLET_CHECK(ordered);
+    STARLET_CHECK(drained == ProfileBuffer::CAPACITY);
+
+    // Draining frees the ring for new zones.
+    buffer->push("zone", 0, 1);
+    drained = 0;
+    buffer->drain([&](const ProfileEvent&) { ++drained; });
+    STARLET_CHECK(drained == 1);
+  }
+
+  void internedNamesAreStable() {
+    Profiler& profiler = Profiler::get();
+    const char* first = profiler.intern("AnimationSystem");
+    for (int i = 0; i < 100; ++i) profiler.intern("System" + std::to_string(i));
+    STARLET_CHECK(profiler.intern("AnimationSystem") == first);
+    STARLET_CHECK(std::string(first) == "AnimationSystem");
+  }
+
+  void captureWritesChromeTrace() {
+    const std::string path = (std::filesystem::temp_directory_path() / "starlet_profiler_test.json").string();
+    Profiler& profiler = Profiler::get();
+    STARLET_CHECK(!profiler.endCapture(path));
+
+    profiler.beginCapture();
+    STARLET_CHECK(profiler.isCapturing());
+    profiler.endFrame();
+    { ProfileZone zone("MainZone"); }
+    std::thread([] { ProfileZone zone("WorkerZone"); }).join();
+    {
+      std::string runtime = "Physics \"fixed\"";
+      ProfileZone zone(profiler.intern(runtime));
+      runtime.clear();
+    }
+    profiler.endFrame();
+    STARLET_CHECK(profiler.endCapture(path));
+    STARLET_CHECK(!profiler.isCapturing());
+
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    const std::string trace = text.str();
+    STARLET_CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    STARLET_CHECK(trace.find("\"name\":\"MainZone\",\"ph\":\"X\"") != std::string::npos);
+    STARLET_CHECK(trace.find("\"name\":\"WorkerZone\"") != std::string::npos);
+    STARLET_CHECK(trace.find("\"name\":\"Frame\"") != std::string::npos);
+    STARLET_CHECK(trace.find("\"name\":\"Physics _fixed_\"") != std::string::npos);
+    STARLET_CHECK(profiler.getFrameStats().getCount() >= 1);
+    std::remove(path.c_str());
+  }
+}
+
+int main() {
+  bufferDropsWhenFull();
+  internedNamesAreStable();
+  captureWritesChromeTrace();
+  return 0;
+}
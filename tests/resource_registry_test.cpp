@@ -0,0 +1,78 @@
+#include "check.hpp"
+
+#include "starlet-engine/resource_registry.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  void sharesAndEvicts() {
+    ResourceRegistry registry;
+    int released = 0;
+
+    ResourceList outgoing;
+    outgoing.push_back(registry.insert(1, [&] { ++released; }, 100));
+    outgoing.push_back(registry.insert(2, [&] { ++released; }, 50));
+    STARLET_CHECK(registry.getResidentCount() == 2);
+    STARLET_CHECK(registry.getResidentBytes() == 150);
+
+    // The incoming scene shares key 1; a duplicate upload is released at once.
+    ResourceList incoming;
+    incoming.push_back(registry.acquire(1));
+    STARLET_CHECK(incoming.back().isValid());
+    incoming.push_back(registry.insert(1, [&] { released += 10; }, 100));
+    STARLET_CHECK(released == 10);
+    STARLET_CHECK(!registry.acquire(3).isValid());
+
+    outgoing.clear();
+    STARLET_CHECK(registry.collect() == 1);
+    STARLET_CHECK(released == 11);
+    STARLET_CHECK(registry.isResident(1));
+    STARLET_CHECK(!registry.isResident(2));
+    STARLET_CHECK(registry.getResidentBytes() == 100);
+
+    incoming.clear();
+    STARLET_CHECK(registry.collect() == 1);
+    STARLET_CHECK(registry.getResidentCount() == 0);
+  }
+
+  void handlesCount() {
+    ResourceRegistry registry;
+    ResourceHandle first = registry.insert(7, [] {});
+    ResourceHandle copy = first;
+    ResourceHandle moved = std::move(first);
+    STARLET_CHECK(!first.isValid());
+    STARLET_CHECK(copy.getKey() == 7 && moved.getKey() == 7);
+
+    copy = ResourceHandle();
+    STARLET_CHECK(registry.collect() == 0);
+    moved = ResourceHandle();
+    STARLET_CHECK(registry.collect() == 1);
+  }
+
+  void keysByContent() {
+    const fs::path root = fs::temp_directory_path() / "starlet_resource_registry_test";
+    fs::create_directories(root);
+    std::ofstream(root / "a.ply", std::ios::binary) << "same bytes";
+    std::ofstream(root / "b.ply", std::ios::binary) << "same bytes";
+    std::ofstream(root / "c.ply", std::ios::binary) << "other bytes";
+
+    const ResourceKey a = ResourceRegistry::keyForFile((root / "a.ply").string(), "mesh");
+    STARLET_CHECK(a != 0);
+    STARLET_CHECK(a == ResourceRegistry::keyForFile((root / "b.ply").string(), "mesh"));
+    STARLET_CHECK(a != ResourceRegistry::keyForFile((root / "c.ply").string(), "mesh"));
+    STARLET_CHECK(a != ResourceRegistry::keyForFile((root / "a.ply").string(), "texture"));
+    STARLET_CHECK(ResourceRegistry::keyForFile((root / "missing.ply").string(), "mesh") == 0);
+    fs::remove_all(root);
+  }
+}
+
+int main() {
+  sharesAndEvicts();
+  handlesCount();
+  keysByContent();
+  return 0;
+}
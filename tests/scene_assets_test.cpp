@@ -0,0 +1,58 @@
+#include "check.hpp"
+
+#include "starlet-engine/scene_assets.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace Starlet::Engine;
+namespace fs = std::filesystem;
+
+namespace {
+  void writeFile(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << text;
+  }
+
+  bool contains(const std::vector<std::string>& list, const fs::path& path) {
+    return std::find(list.begin(), list.end(), path.generic_string()) != list.end();
+  }
+}
+
+int main() {
+  const fs::path root = fs::temp_directory_path() / "starlet_scene_assets_test";
+  fs::remove_all(root);
+  writeFile(root / "models" / "cube.ply", "ply");
+  writeFile(root / "models" / "unused.ply", "ply");
+  writeFile(root / "textures" / "wood.png", "png");
+  writeFile(root / "cache" / "cube.ply", "cooked");
+
+  AssetIndex index;
+  STARLET_CHECK(index.empty());
+  index.build(root.string(), { "cache" });
+  STARLET_CHECK(index.contains("models/cube.ply"));
+  STARLET_CHECK(index.contains("wood.png"));
+  STARLET_CHECK(!index.contains("cache/cube.ply"));
+
+  // Scenes name files by relative path or bare name; both resolve to one file.
+  const std::vector<std::string> found = index.resolve({ "models/cube.ply", "cube.ply", "./textures/../textures/wood.png", "missing.ply" });
+  STARLET_CHECK(found.size() == 2);
+  STARLET_CHECK(found[0] == (root / "models" / "cube.ply").generic_string());
+  STARLET_CHECK(contains(found, root / "textures" / "wood.png"));
+  STARLET_CHECK(!contains(found, root / "models" / "unused.ply"));
+  STARLET_CHECK(!contains(found, root / "cache" / "cube.ply"));
+
+  // Files added after the build are found once the index is rebuilt.
+  writeFile(root / "models" / "new.ply", "ply");
+  STARLET_CHECK(index.resolve({ "new.ply" }).empty());
+  index.clear();
+  index.build(root.string(), { "cache" });
+  STARLET_CHECK(index.resolve({ "new.ply" }).size() == 1);
+
+  STARLET_CHECK(prefetchFile((root / "textures" / "wood.png").string()));
+  STARLET_CHECK(!prefetchFile((root / "nope.bin").string()));
+
+  fs::remove_all(root);
+  return 0;
+}
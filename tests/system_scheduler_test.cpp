@@ -0,0 +1,52 @@
+#include "check.hpp"
+
+#include "starlet-engine/system_scheduler.hpp"
+#include "starlet-engine/frame_context.hpp"
+#include "starlet-engine/job_system.hpp"
+
+#include <atomic>
+
+using namespace Starlet::Engine;
+
+namespace {
+  struct Position {};
+  struct Velocity {};
+
+  void conflictingSystemsGetLaterPhases() {
+    SystemScheduler scheduler;
+    scheduler.add("move", SystemAccess().read<Velocity>().write<Position>(), [](const FrameContext&) { return false; });
+    scheduler.add("render", SystemAccess().read<Position>(), [](const FrameContext&) { return false; });
+    scheduler.add("spin", SystemAccess().write<Velocity>(), [](const FrameContext&) { return false; });
+    scheduler.add("idle", SystemAccess(), [](const FrameContext&) { return false; });
+    STARLET_CHECK(scheduler.getPhaseCount() == 2);
+  }
+
+  void runReportsWhetherAnySystemChanged() {
+    JobSystem jobs(2);
+    FrameArenas arenas(jobs.getThreadCount(), 1024);
+    FrameContext frame;
+    frame.jobs = &jobs;
+    frame.arenas = &arenas;
+
+    std::atomic<int> ran{ 0 };
+    bool moved = false;
+    SystemScheduler scheduler;
+    scheduler.add("a", SystemAccess(), [&ran](const FrameContext&) { ++ran; return false; });
+    scheduler.add("b", SystemAccess(), [&ran, &moved](const FrameContext&) { ++ran; return moved; });
+    scheduler.add("c", SystemAccess(), [&ran](const FrameContext&) { ++ran; return false; });
+
+    STARLET_CHECK(!scheduler.run(jobs, frame));
+    STARLET_CHECK(ran == 3);
+
+    // A change from a system running on a worker still reaches the caller.
+    moved = true;
+    STARLET_CHECK(scheduler.run(jobs, frame));
+    STARLET_CHECK(ran == 6);
+  }
+}
+
+int main() {
+  conflictingSystemsGetLaterPhases();
+  runReportsWhetherAnySystemChanged();
+  return 0;
+}
@@ -0,0 +1,583 @@
+#include "starlet-engine/cooked_assets.hpp"
+#include "starlet-engine/content_hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// starlet_asset_cook: converts the meshes (.ply) and textures (.bmp) under an
+// asset directory into the GPU-ready .smesh / .stex files the engine maps at
+// load time. Meshes are interleaved, reordered for the post-transform vertex
+// cache and use 16-bit indices when they fit; textures get a full mip chain
+// and, with --bc1, block compression when fully opaque.
+//
+// Usage: starlet_asset_cook [--check] [--force] [--bc1] <assets dir>
+//   --check  only report valid/missing/stale per asset; exits 2 if any needs cooking
+//   --force  re-cook assets that are already up to date
+
+namespace {
+  namespace fs = std::filesystem;
+  using namespace Starlet::Engine;
+
+  struct Options {
+    std::string assets;
+    bool checkOnly{ false };
+    bool force{ false };
+    bool compress{ false };
+  };
+
+  const char* statusName(const CookStatus status) {
+    switch (status) {
+    case CookStatus::Valid:    return "valid";
+    case CookStatus::Missing:  return "missing";
+    case CookStatus::Stale:    return "stale";
+    case CookStatus::NoSource: return "no-source";
+    }
+    return "unknown";
+  }
+
+  // Stamped before hashing, so a source edited meanwhile no longer matches the stamp and is rehashed.
+  template<typename Header>
+  bool stampSource(const std::string& sourcePath, Header& header) {
+    return readSourceStamp(sourcePath, header.sourceSize, header.sourceModified) && hashFile(sourcePath, header.sourceHash);
+  }
+
+  // ---- PLY ----------------------------------------------------------------
+
+  struct SourceMesh {
+    std::uint32_t attributes{ 0 };
+    std::vector<float> positions, normals, texcoords;
+    std::vector<unsigned char> colors;
+    std::vector<std::uint32_t> indices;
+
+    size_t vertexCount() const { return positions.size() / 3; }
+  };
+
+  struct PlyProperty {
+    std::string name;
+    std::string type;
+    std::string countType; // non-empty for list properties
+  };
+
+  struct PlyElement {
+    std::string name;
+    size_t count{ 0 };
+    std::vector<PlyProperty> properties;
+  };
+
+  size_t plyTypeSize(const std::string& type) {
+    if (type == "char" || type == "uchar" || type == "int8" || type == "uint8") return 1;
+    if (type == "short" || type == "ushort" || type == "int16" || type == "uint16") return 2;
+    if (type == "int" || type == "uint" || type == "float" || type == "int32" || type == "uint32" || type == "float32") return 4;
+    if (type == "double" || type == "float64") return 8;
+    return 0;
+  }
+
+  double readBinaryScalar(const unsigned char*& cursor, const std::string& type) {
+    const size_t size = plyTypeSize(type);
+    unsigned char bytes[8] = {};
+    std::memcpy(bytes, cursor, size);
+    cursor += size;
+
+    if (type == "char" || type == "int8")    return static_cast<std::int8_t>(bytes[0]);
+    if (type == "uchar" || type == "uint8")  return bytes[0];
+    if (type == "short" || type == "int16")  { std::int16_t v; std::memcpy(&v, bytes, 2); return v; }
+    if (type == "ushort" || type == "uint16") { std::uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+    if (type == "int" || type == "int32")    { std::int32_t v; std::memcpy(&v, bytes, 4); return v; }
+    if (type == "uint" || type == "uint32")  { std::uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+    if (type == "float" || type == "float32") { float v; std::memcpy(&v, bytes, 4); return v; }
+    double v; std::memcpy(&v, bytes, 8); return v;
+  }
+
+  // Reads ASCII and little-endian binary PLY: vertex x/y/z plus optional
+  // normals, texture coordinates and colors, and polygon faces (fan-triangulated).
+  bool readPly(const std::string& path, SourceMesh& mesh) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::string line;
+    if (!std::getline(file, line) || line.rfind("ply", 0) != 0) return false;
+
+    bool binary = false;
+    std::vector<PlyElement> elements;
+    while (std::getline(file, line)) {
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      std::istringstream words(line);
+      std::string keyword;
+      words >> keyword;
+
+      if (keyword == "format") {
+        std::string format;
+        words >> format;
+        if (format == "binary_little_endian") binary = true;
+        else if (format != "ascii") return false;
+      }
+      else if (keyword == "element") {
+        PlyElement element;
+        words >> element.name >> element.count;
+        elements.push_back(element);
+      }
+      else if (keyword == "property" && !elements.empty()) {
+        PlyProperty property;
+        words >> property.type;
+        if (property.type == "list") words >> property.countType >> property.type;
+        words >> property.name;
+        if (plyTypeSize(property.type) == 0 || (!property.countType.empty() && plyTypeSize(property.countType) == 0)) return false;
+        elements.back().properties.push_back(property);
+      }
+      else if (keyword == "end_header") break;
+    }
+
+    std::vector<unsigned char> body;
+    if (binary) body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    const unsigned char* cursor = body.data();
+    const unsigned char* bodyEnd = body.data() + body.size();
+
+    for (const PlyElement& element : elements) {
+      const bool isVertex = element.name == "vertex";
+      const bool isFace = element.name == "face";
+
+      if (isVertex) {
+        for (const PlyProperty& property : element.properties) {
+          const std::string& n = property.name;
+          if (n == "nx") mesh.attributes |= VERTEX_NORMAL;
+          if (n == "u" || n == "s" || n == "texture_u") mesh.attributes |= VERTEX_TEXCOORD;
+          if (n == "red") mesh.attributes |= VERTEX_COLOR;
+        }
+        mesh.attributes |= VERTEX_POSITION;
+      }
+
+      std::vector<double> values;
+      std::istringstream words;
+      for (size_t item = 0; item < element.count; ++item) {
+        if (!binary) {
+          if (!std::getline(file, line)) return false;
+          words.clear();
+          words.str(line);
+        }
+
+        const auto next = [&](const std::string& type, double& value) {
+          if (!binary) return static_cast<bool>(words >> value);
+          if (cursor + plyTypeSize(type) > bodyEnd) return false;
+          value = readBinaryScalar(cursor, type);
+          return true;
+        };
+
+        float vertex[3] = {}, normal[3] = {}, texcoord[2] = {};
+        unsigned char color[4] = { 255, 255, 255, 255 };
+        for (const PlyProperty& property : element.properties) {
+          double value = 0.0;
+          if (property.countType.empty()) {
+            if (!next(property.type, value)) return false;
+            if (!isVertex) continue;
+
+            const std::string& n = property.name;
+            if (n == "x") vertex[0] = static_cast<float>(value);
+            else if (n == "y") vertex[1] = static_cast<float>(value);
+            else if (n == "z") vertex[2] = static_cast<float>(value);
+            else if (n == "nx") normal[0] = static_cast<float>(value);
+            else if (n == "ny") normal[1] = static_cast<float>(value);
+            else if (n == "nz") normal[2] = static_cast<float>(value);
+            else if (n == "u" || n == "s" || n == "texture_u") texcoord[0] = static_cast<float>(value);
+            else if (n == "v" || n == "t" || n == "texture_v") texcoord[1] = static_cast<float>(value);
+            else if (n == "red" || n == "green" || n == "blue" || n == "alpha") {
+              const int channel = n == "red" ? 0 : n == "green" ? 1 : n == "blue" ? 2 : 3;
+              const double scaled = property.type == "float" || property.type == "float32" || property.type == "double" ? value * 255.0 : value;
+              color[channel] = static_cast<unsigned char>(std::clamp(scaled, 0.0, 255.0));
+            }
+            continue;
+          }
+
+          double count = 0.0;
+          if (!next(property.countType, count)) return false;
+          values.resize(static_cast<size_t>(count));
+          for (double& v : values)
+            if (!next(property.type, v)) return false;
+
+          if (isFace && (property.name == "vertex_indices" || property.name == "vertex_index"))
+            for (size_t i = 2; i < values.size(); ++i) {
+              mesh.indices.push_back(static_cast<std::uint32_t>(values[0]));
+              mesh.indices.push_back(static_cast<std::uint32_t>(values[i - 1]));
+              mesh.indices.push_back(static_cast<std::uint32_t>(values[i]));
+            }
+        }
+
+        if (!isVertex) continue;
+        mesh.positions.insert(mesh.positions.end(), vertex, vertex + 3);
+        if (mesh.attributes & VERTEX_NORMAL) mesh.normals.insert(mesh.normals.end(), normal, normal + 3);
+        if (mesh.attributes & VERTEX_TEXCOORD) mesh.texcoords.insert(mesh.texcoords.end(), texcoord, texcoord + 2);
+        if (mesh.attributes & VERTEX_COLOR) mesh.colors.insert(mesh.colors.end(), color, color + 4);
+      }
+    }
+
+    const size_t vertexCount = mesh.vertexCount();
+    return vertexCount > 0 && std::all_of(mesh.indices.begin(), mesh.indices.end(), [vertexCount](const std::uint32_t i) { return i < vertexCount; });
+  }
+
+  // ---- Vertex cache optimization --------------------------------------------
+
+  // Tom Forsyth's linear-speed vertex cache optimisation: greedily emits the
+  // triangle whose vertices score highest for recent cache use and low
+  // remaining valence.
+  constexpr int CACHE_SIZE = 32;
+
+  float vertexScore(const int cachePosition, const unsigned int remaining) {
+    if (remaining == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+      score = cachePosition < 3
+        ? 0.75f
+        : std::pow(1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(CACHE_SIZE - 3), 1.5f);
+    }
+    return score + 2.0f / std::sqrt(static_cast<float>(remaining));
+  }
+
+  void optimizeVertexCache(std::vector<std::uint32_t>& indices, const size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<unsigned int> remaining(vertexCount, 0);
+    for (const std::uint32_t index : indices) ++remaining[index];
+
+    std::vector<size_t> adjacencyStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+    std::vector<std::uint32_t> adjacency(indices.size());
+    std::vector<size_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t)
+      for (int corner = 0; corner < 3; ++corner) adjacency[fill[indices[t * 3 + corner]]++] = static_cast<std::uint32_t>(t);
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) score[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; ++t)
+      triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<std::uint32_t> cache, nextCache;
+    size_t scanCursor = 0;
+    std::int64_t best = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+      if (best < 0) {
+        while (emitted[scanCursor]) ++scanCursor;
+        best = static_cast<std::int64_t>(scanCursor);
+      }
+
+      const size_t t = static_cast<size_t>(best);
+      emitted[t] = true;
+      nextCache.clear();
+      for (int corner = 0; corner < 3; ++corner) {
+        const std::uint32_t v = indices[t * 3 + corner];
+        output.push_back(v);
+        nextCache.push_back(v);
+        --remaining[v];
+
+        // Drop the emitted triangle from the vertex's live adjacency.
+        const auto begin = adjacency.begin() + static_cast<std::ptrdiff_t>(adjacencyStart[v]);
+        const auto end = begin + static_cast<std::ptrdiff_t>(remaining[v] + 1);
+        std::iter_swap(std::find(begin, end, static_cast<std::uint32_t>(t)), end - 1);
+      }
+      for (const std::uint32_t v : cache)
+        if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+
+      // Vertices pushed past the cache end fall out and are rescored as uncached.
+      for (size_t i = 0; i < nextCache.size(); ++i) {
+        const std::uint32_t v = nextCache[i];
+        cachePosition[v] = i < static_cast<size_t>(CACHE_SIZE) ? static_cast<int>(i) : -1;
+        score[v] = vertexScore(cachePosition[v], remaining[v]);
+      }
+      if (nextCache.size() > static_cast<size_t>(CACHE_SIZE)) nextCache.resize(CACHE_SIZE);
+      cache.swap(nextCache);
+
+      best = -1;
+      float bestScore = -1.0f;
+      for (const std::uint32_t v : cache)
+        for (size_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+          const std::uint32_t candidate = adjacency[a];
+          triangleScore[candidate] = score[indices[candidate * 3]] + score[indices[candidate * 3 + 1]] + score[indices[candidate * 3 + 2]];
+          if (triangleScore[candidate] > bestScore) {
+            bestScore = triangleScore[candidate];
+            best = candidate;
+          }
+        }
+    }
+    indices.swap(output);
+  }
+
+  // Renumbers vertices in first-use order so fetches walk the buffer linearly.
+  std::vector<std::uint32_t> vertexFetchOrder(std::vector<std::uint32_t>& indices, const size_t vertexCount) {
+    std::vector<std::uint32_t> remap(vertexCount, ~0u), order;
+    order.reserve(vertexCount);
+    for (std::uint32_t& index : indices) {
+      if (remap[index] == ~0u) {
+        remap[index] = static_cast<std::uint32_t>(order.size());
+        order.push_back(index);
+      }
+      index = remap[index];
+    }
+    // Unreferenced vertices are kept at the end so counts stay unchanged.
+    for (std::uint32_t v = 0; v < vertexCount; ++v)
+      if (remap[v] == ~0u) order.push_back(v);
+    return order;
+  }
+
+  bool cookMesh(const std::string& sourcePath) {
+    SourceMesh mesh;
+    if (!readPly(sourcePath, mesh)) {
+      std::fprintf(stderr, "Failed to read mesh: %s\n", sourcePath.c_str());
+      return false;
+    }
+
+    const size_t vertexCount = mesh.vertexCount();
+    optimizeVertexCache(mesh.indices, vertexCount);
+    const std::vector<std::uint32_t> order = vertexFetchOrder(mesh.indices, vertexCount);
+
+    CookedMeshHeader header{ CookedMesh::MAGIC, CookedMesh::FORMAT_VERSION, 0, 0, 0, mesh.attributes, CookedMesh::strideFor(mesh.attributes),
+      static_cast<std::uint32_t>(vertexCount), static_cast<std::uint32_t>(mesh.indices.size()), vertexCount <= 0xFFFF ? 2u : 4u, 0 };
+    if (!stampSource(sourcePath, header)) return false;
+
+    std::vector<unsigned char> vertices(vertexCount * header.vertexStride);
+    unsigned char* out = vertices.data();
+    const auto put = [&out](const void* data, const size_t bytes) {
+      std::memcpy(out, data, bytes);
+      out += bytes;
+    };
+    for (const std::uint32_t v : order) {
+      put(&mesh.positions[v * 3], 3 * sizeof(float));
+      if (mesh.attributes & VERTEX_NORMAL)   put(&mesh.normals[v * 3], 3 * sizeof(float));
+      if (mesh.attributes & VERTEX_TEXCOORD) put(&mesh.texcoords[v * 2], 2 * sizeof(float));
+      if (mesh.attributes & VERTEX_COLOR)    put(&mesh.colors[v * 4], 4);
+    }
+
+    std::vector<unsigned char> indices(mesh.indices.size() * header.indexSize);
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+      if (header.indexSize == 2) {
+        const std::uint16_t index = static_cast<std::uint16_t>(mesh.indices[i]);
+        std::memcpy(indices.data() + i * 2, &index, 2);
+      }
+      else std::memcpy(indices.data() + i * 4, &mesh.indices[i], 4);
+    }
+
+    return CookedMesh::write(CookedMesh::cookedPathFor(sourcePath), header, vertices, indices);
+  }
+
+  // ---- BMP ----------------------------------------------------------------
+
+  struct Image {
+    std::uint32_t width{ 0 }, height{ 0 };
+    std::vector<unsigned char> rgba; // bottom row first, as GL expects
+  };
+
+  std::uint32_t readLE(const unsigned char* data, const int bytes) {
+    std::uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | data[i];
+    return value;
+  }
+
+  // Uncompressed 24-bit and 32-bit (BI_RGB or BGRA bitfields) BMP.
+  bool readBmp(const std::string& path, Image& image) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 54 || data[0] != 'B' || data[1] != 'M') return false;
+
+    const std::uint32_t pixelOffset = readLE(&data[10], 4);
+    const std::int32_t width = static_cast<std::int32_t>(readLE(&data[18], 4));
+    const std::int32_t height = static_cast<std::int32_t>(readLE(&data[22], 4));
+    const std::uint32_t bitsPerPixel = readLE(&data[28], 2);
+    const std::uint32_t compression = readLE(&data[30], 4);
+    if (width <= 0 || height == 0 || (bitsPerPixel != 24 && bitsPerPixel != 32) || (compression != 0 && compression != 3)) return false;
+
+    const bool topDown = height < 0;
+    image.width = static_cast<std::uint32_t>(width);
+    image.height = static_cast<std::uint32_t>(topDown ? -height : height);
+
+    const size_t bytesPerPixel = bitsPerPixel / 8;
+    const size_t rowBytes = (image.width * bytesPerPixel + 3) & ~size_t{ 3 };
+    if (pixelOffset + rowBytes * image.height > data.size()) return false;
+
+    image.rgba.resize(size_t{ image.width } * image.height * 4);
+    for (std::uint32_t y = 0; y < image.height; ++y) {
+      const std::uint32_t sourceRow = topDown ? image.height - 1 - y : y;
+      const unsigned char* row = &data[pixelOffset + sourceRow * rowBytes];
+      unsigned char* out = &image.rgba[size_t{ y } * image.width * 4];
+      for (std::uint32_t x = 0; x < image.width; ++x, row += bytesPerPixel, out += 4) {
+        out[0] = row[2];
+        out[1] = row[1];
+        out[2] = row[0];
+        out[3] = bytesPerPixel == 4 ? row[3] : 255;
+      }
+    }
+    return true;
+  }
+
+  // 2x2 box filter; odd edges reuse the last texel.
+  Image downsample(const Image& source) {
+    Image mip;
+    mip.width = std::max(1u, source.width / 2);
+    mip.height = std::max(1u, source.height / 2);
+    mip.rgba.resize(size_t{ mip.width } * mip.height * 4);
+
+    for (std::uint32_t y = 0; y < mip.height; ++y)
+      for (std::uint32_t x = 0; x < mip.width; ++x)
+        for (int c = 0; c < 4; ++c) {
+          const std::uint32_t x0 = std::min(x * 2, source.width - 1), x1 = std::min(x * 2 + 1, source.width - 1);
+          const std::uint32_t y0 = std::min(y * 2, source.height - 1), y1 = std::min(y * 2 + 1, source.height - 1);
+          const auto texel = [&](const std::uint32_t tx, const std::uint32_t ty) { return source.rgba[(size_t{ ty } * source.width + tx) * 4 + c]; };
+          mip.rgba[(size_t{ y } * mip.width + x) * 4 + c] = static_cast<unsigned char>((texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1) + 2) / 4);
+        }
+    return mip;
+  }
+
+  std::uint16_t toRgb565(const unsigned char* color) {
+    return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+  }
+
+  void fromRgb565(const std::uint16_t packed, int* color) {
+    color[0] = ((packed >> 11) & 31) * 255 / 31;
+    color[1] = ((packed >> 5) & 63) * 255 / 63;
+    color[2] = (packed & 31) * 255 / 31;
+  }
+
+  // BC1 (DXT1) in opaque four-colour mode, with endpoints from the block's
+  // colour bounding box. Fast rather than optimal; the cook is offline but
+  // runs over whole asset trees.
+  void compressBc1(const Image& image, std::vector<unsigned char>& out) {
+    const std::uint32_t blocksX = (image.width + 3) / 4, blocksY = (image.height + 3) / 4;
+    for (std::uint32_t by = 0; by < blocksY; ++by)
+      for (std::uint32_t bx = 0; bx < blocksX; ++bx) {
+        unsigned char block[16][4];
+        unsigned char low[3] = { 255, 255, 255 }, high[3] = { 0, 0, 0 };
+        for (int i = 0; i < 16; ++i) {
+          const std::uint32_t x = std::min(bx * 4 + i % 4, image.width - 1), y = std::min(by * 4 + i / 4, image.height - 1);
+          std::memcpy(block[i], &image.rgba[(size_t{ y } * image.width + x) * 4], 4);
+          for (int c = 0; c < 3; ++c) {
+            low[c] = std::min(low[c], block[i][c]);
+            high[c] = std::max(high[c], block[i][c]);
+          }
+        }
+
+        std::uint16_t color0 = toRgb565(high), color1 = toRgb565(low);
+        if (color0 < color1) std::swap(color0, color1);
+
+        int palette[4][3];
+        fromRgb565(color0, palette[0]);
+        fromRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+          palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+          palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        std::uint32_t selectors = 0;
+        if (color0 != color1) {
+          for (int i = 0; i < 16; ++i) {
+            int bestIndex = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+              int distance = 0;
+              for (int c = 0; c < 3; ++c) distance += (block[i][c] - palette[p][c]) * (block[i][c] - palette[p][c]);
+              if (distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = p;
+              }
+            }
+            selectors |= static_cast<std::uint32_t>(bestIndex) << (i * 2);
+          }
+        }
+
+        const unsigned char encoded[8] = {
+          static_cast<unsigned char>(color0 & 0xFF), static_cast<unsigned char>(color0 >> 8),
+          static_cast<unsigned char>(color1 & 0xFF), static_cast<unsigned char>(color1 >> 8),
+          static_cast<unsigned char>(selectors & 0xFF), static_cast<unsigned char>((selectors >> 8) & 0xFF),
+          static_cast<unsigned char>((selectors >> 16) & 0xFF), static_cast<unsigned char>(selectors >> 24),
+        };
+        out.insert(out.end(), encoded, encoded + 8);
+      }
+  }
+
+  bool cookTexture(const std::string& sourcePath, const bool compress) {
+    Image image;
+    if (!readBmp(sourcePath, image)) {
+      std::fprintf(stderr, "Failed to read texture: %s\n", sourcePath.c_str());
+      return false;
+    }
+
+    bool opaque = true;
+    for (size_t i = 3; i < image.rgba.size() && opaque; i += 4) opaque = image.rgba[i] == 255;
+    const bool bc1 = compress && opaque;
+    if (compress && !opaque) std::printf("note       %s has alpha, kept as RGBA8\n", sourcePath.c_str());
+
+    CookedTextureHeader header{ CookedTexture::MAGIC, CookedTexture::FORMAT_VERSION, 0, 0, 0,
+      static_cast<std::uint32_t>(bc1 ? CookedTextureFormat::BC1 : CookedTextureFormat::RGBA8), 0, image.width, image.height };
+    if (!stampSource(sourcePath, header)) return false;
+
+    std::vector<CookedMipLevel> mips;
+    std::vector<unsigned char> pixels;
+    for (Image level = std::move(image);; level = downsample(level)) {
+      const size_t offset = pixels.size();
+      if (bc1) compressBc1(level, pixels);
+      else pixels.insert(pixels.end(), level.rgba.begin(), level.rgba.end());
+      mips.push_back({ level.width, level.height, offset, pixels.size() - offset });
+
+      if (level.width == 1 && level.height == 1) break;
+    }
+    header.mipCount = static_cast<std::uint32_t>(mips.size());
+
+    return CookedTexture::write(CookedTexture::cookedPathFor(sourcePath), header, mips, pixels);
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--check") options.checkOnly = true;
+    else if (arg == "--force") options.force = true;
+    else if (arg == "--bc1") options.compress = true;
+    else options.assets = arg;
+  }
+
+  std::error_code ec;
+  if (options.assets.empty() || !fs::is_directory(options.assets, ec)) {
+    std::fprintf(stderr, "Usage: %s [--check] [--force] [--bc1] <assets dir>\n", argv[0]);
+    return 1;
+  }
+
+  int outdated = 0, failed = 0, cooked = 0;
+  for (fs::recursive_directory_iterator it(options.assets, ec), end; it != end; it.increment(ec)) {
+    if (!it->is_regular_file(ec)) continue;
+
+    const std::string extension = it->path().extension().string();
+    const bool isMesh = extension == ".ply";
+    const bool isTexture = extension == ".bmp";
+    if (!isMesh && !isTexture) continue;
+
+    const std::string sourcePath = it->path().string();
+    const CookStatus status = isMesh ? CookedMesh::check(sourcePath) : CookedTexture::check(sourcePath);
+    if (options.checkOnly || (status == CookStatus::Valid && !options.force)) {
+      std::printf("%-10s %s\n", statusName(status), sourcePath.c_str());
+      if (status != CookStatus::Valid) ++outdated;
+      continue;
+    }
+
+    if (isMesh ? cookMesh(sourcePath) : cookTexture(sourcePath, options.compress)) {
+      std::printf("cooked     %s\n", sourcePath.c_str());
+      ++cooked;
+    }
+    else ++failed;
+  }
+
+  if (!options.checkOnly) std::printf("%d cooked, %d failed\n", cooked, failed);
+  if (failed > 0) return 1;
+  return options.checkOnly && outdated > 0 ? 2 : 0;
+}